@@ -0,0 +1,173 @@
+/**
+ * @file ChunkedGrid.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "Grid.h"
+
+#include <array>
+
+/**
+ * A sparse grid for huge worlds that are mostly open or mostly solid. The world is split into 64x64 chunks. Chunks
+ * that are entirely empty or entirely walls are stored as a single tag, and only mixed chunks allocate storage
+ * (a bit per cell, one 64 bit word per row). Copies share mixed chunks until one of them writes to it.\n
+ * For comparison, a dense Grid costs about 6.2 bytes per cell: the padded cells and move masks (1 byte each), the
+ * wall distances (4 bytes) and the free cell index. That is about 1.7 GB for a 16384x16384 world.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class ChunkedGrid
+{
+public:
+    static constexpr int chunkShift = 6;
+    static constexpr int chunkSize  = 1 << chunkShift;
+    static constexpr int chunkMask  = chunkSize - 1;
+    
+    /**
+     * What a chunk holds.
+     * @enum Empty - Every cell is empty. No storage is allocated.
+     * @enum Wall - Every cell is a wall. No storage is allocated.
+     * @enum Mixed - A bit per cell is allocated.
+     */
+    enum class chunkType : unsigned char { Empty, Wall, Mixed, Count };
+    
+    /**
+     * @brief The cells of a mixed chunk. Bit x of row y is set if the cell is a wall.
+     */
+    struct Chunk
+    {
+        std::array<uint64_t, chunkSize> rows {};
+    };
+    
+    /**
+     * @brief How many chunks there are of a type and how much memory they use.
+     */
+    struct ChunkStats
+    {
+        uint64_t count       { 0 };
+        uint64_t memoryBytes { 0 };
+        double   lookupNanoseconds { 0.0 };  // Only filled in by measureLookupCost().
+    };
+    
+    typedef std::array<ChunkStats, static_cast<size_t>(chunkType::Count)> Stats;
+    
+public:
+    /**
+     * @param size - The width and height of the world.
+     * @param fill - What every cell starts as (Empty or Wall).
+     */
+    explicit ChunkedGrid(const glm::ivec2 &size, Grid::cellType fill=Grid::cellType::Empty);
+    
+    /**
+     * @brief Copies a dense grid into chunks.
+     * @param grid - The grid/maze to copy.
+     */
+    explicit ChunkedGrid(const Grid &grid);
+    
+    /**
+     * @param pos - The position to query.
+     * @returns The type of the cell (Empty or Wall). Anything outside of the world is a wall.
+     */
+    [[nodiscard]] Grid::cellType getCellType(const glm::ivec2 &pos) const;
+    
+    /**
+     * @param pos - The position to query.
+     * @returns True if the position is inside of the world and is not a wall.
+     */
+    [[nodiscard]] bool verifyCell(const glm::ivec2 &pos) const;
+    
+    /**
+     * @brief Changes a single cell. Allocates the chunk if it was uniform and frees it if it becomes uniform.
+     * @param pos - The position of the cell. Ignored if it is outside of the world.
+     * @param type - The new type of the cell (Empty or Wall).
+     */
+    void setCell(const glm::ivec2 &pos, Grid::cellType type);
+    
+    /**
+     * @brief Changes every cell in [min, max]. Chunks that are completely covered become uniform without
+     * allocating.
+     * @param min - The top left of the area (inclusive).
+     * @param max - The bottom right of the area (inclusive).
+     * @param type - The new type of the cells (Empty or Wall).
+     */
+    void fillRect(const glm::ivec2 &min, const glm::ivec2 &max, Grid::cellType type);
+    
+    /**
+     * @brief Gets the legal moves from a cell in the same format as Grid::getMoveMask(). Cells inside of a chunk
+     * (not on its border) are answered from that chunk alone.
+     * @param pos - The position to move from.
+     * @returns A bit mask of the legal moves.
+     */
+    [[nodiscard]] uint8_t getMoveMask(const glm::ivec2 &pos) const;
+    
+    /**
+     * @returns The width and height of the world.
+     */
+    [[nodiscard]] const glm::ivec2 &getSize() const;
+    
+    /**
+     * @param chunk - The chunk coordinates (position / chunkSize).
+     * @returns What the chunk holds.
+     */
+    [[nodiscard]] chunkType getChunkType(const glm::ivec2 &chunk) const;
+    
+    /**
+     * @returns The number of chunks and the memory used for each chunk type.
+     */
+    [[nodiscard]] Stats getStats() const;
+    
+    /**
+     * @brief Same as getStats() but also times random look ups inside of each chunk type.
+     * @param samples - The number of look ups to time for each chunk type.
+     */
+    [[nodiscard]] Stats measureLookupCost(int samples=1'000'000) const;
+    
+    /**
+     * @returns The number of bytes used by the whole grid.
+     */
+    [[nodiscard]] uint64_t getMemoryUsage() const;
+
+protected:
+    glm::ivec2                          mSize       { 0 };
+    glm::ivec2                          mChunkCount { 0 };
+    std::vector<chunkType>              mTypes;
+    std::vector<std::shared_ptr<Chunk>> mChunks;  // nullptr unless the chunk is mixed.
+    
+    [[nodiscard]] int chunkIndex(const glm::ivec2 &pos) const;
+    
+    /**
+     * @returns True if the cell at pos (which must be in bounds) is a wall.
+     */
+    [[nodiscard]] bool isWall(const glm::ivec2 &pos) const;
+    
+    /**
+     * @brief Gives the chunk its own storage so that it can be written to. Shared storage is cloned first.
+     * @returns The chunk's storage.
+     */
+    Chunk &makeMixed(int index);
+    
+    /**
+     * @brief Turns a mixed chunk back into a tag if every cell in it is the same.
+     */
+    void collapse(int index);
+    
+    /**
+     * @returns A mask of the columns that are inside of the world for a chunk.
+     */
+    [[nodiscard]] uint64_t columnMask(int index) const;
+    
+    /**
+     * @returns The number of rows that are inside of the world for a chunk.
+     */
+    [[nodiscard]] int rowCount(int index) const;
+};
+
+
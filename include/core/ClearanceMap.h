@@ -0,0 +1,112 @@
+/**
+ * @file ClearanceMap.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+class Grid;
+
+/**
+ * Stores how far each cell is from the nearest wall (anything outside of the grid counts as a wall) so that agents
+ * bigger than a single cell can check if they fit in O(1). Built with a linear time distance transform.
+ * Distances are capped at a maximum so that edits only need to recompute the cells within that distance.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class ClearanceMap
+{
+public:
+    /**
+     * How distance to a wall is measured.
+     * @enum Chessboard - max(∆x, ∆y). An agent with radius r covers a (2r + 1) square of cells.
+     * @enum Euclidean - The straight line distance, rounded down. An agent with radius r covers a circle.
+     */
+    enum class metric : unsigned char { Chessboard, Euclidean };
+    
+public:
+    /**
+     * @param grid - The grid/maze that the clearance is calculated from.
+     * @param distanceMetric - How the distance to each wall is measured.
+     * @param maxClearance - Distances are capped at this value [1, 255]. Agents must have a radius less than this.
+     */
+    explicit ClearanceMap(const Grid &grid, metric distanceMetric=metric::Chessboard, int maxClearance=16);
+    
+    /**
+     * @brief Recalculates the clearance for every cell.
+     * @param grid - The grid/maze that the clearance is calculated from.
+     */
+    void rebuild(const Grid &grid);
+    
+    /**
+     * @brief Recalculates the clearance of the cells that could be affected by an edit. Call after the grid has
+     * been edited.
+     * @param grid - The grid/maze after it has been edited. It must be the same size as before.
+     * @param min - The top left of the cells that changed (inclusive).
+     * @param max - The bottom right of the cells that changed (inclusive).
+     */
+    void onCellsChanged(const Grid &grid, const glm::ivec2 &min, const glm::ivec2 &max);
+    
+    /**
+     * @brief Catches up with every edit made to the grid since the last sync, using the grid's change journal.
+     * Falls back to rebuild() if the journal doesn't go back far enough.
+     * @param grid - The grid/maze that this was built from.
+     */
+    void sync(const Grid &grid);
+    
+    /**
+     * @param cell - The cell to query. There is no bounds checking.
+     * @returns The distance to the nearest wall, 0 if the cell is a wall.
+     */
+    [[nodiscard]] int getClearance(int cell) const { return mClearance[cell]; }
+    
+    /**
+     * @brief Checks if an agent centred on the cell would not touch a wall.
+     * @param cell - The cell to query. There is no bounds checking.
+     * @param radius - The radius of the agent in cells. 0 is a single cell.
+     * @returns True if the agent fits, false otherwise.
+     */
+    [[nodiscard]] bool canFit(int cell, int radius) const { return mClearance[cell] > radius; }
+    
+    /**
+     * @returns The largest distance that is stored.
+     */
+    [[nodiscard]] int getMaxClearance() const;
+    
+    /**
+     * @returns A const ref to the clearance of every cell.
+     */
+    [[nodiscard]] const std::vector<uint8_t> &getClearances() const;
+
+protected:
+    std::vector<uint8_t>    mClearance;
+    glm::ivec2              mSize           { 0 };
+    metric                  mMetric         { metric::Chessboard };
+    int                     mMaxClearance   { 16 };
+    uint64_t                mVersion        { 0 };  // The grid version that this is synced to.
+    
+    /**
+     * @brief Calculates the clearance for the cells in [min, max]. Only the walls within mMaxClearance of the
+     * region are looked at, so the cost is proportional to the size of the region.
+     */
+    void compute(const Grid &grid, const glm::ivec2 &min, const glm::ivec2 &max);
+    
+    /**
+     * @brief Two pass chessboard distance transform. Values must be 0 for walls and large everywhere else.
+     */
+    static void chessboardTransform(std::vector<int64_t> &values, const glm::ivec2 &size);
+    
+    /**
+     * @brief Felzenszwalb and Huttenlocher's squared euclidean distance transform. Values must be 0 for walls
+     * and large everywhere else.
+     */
+    static void euclideanTransform(std::vector<int64_t> &values, const glm::ivec2 &size);
+};
+
+
@@ -15,20 +15,68 @@
 #include <cstdint>
 #include <functional>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif  // _MSC_VER
+
 /**
- * @brief Returns a random float between 0 and 1.
- * @return [0, 1]
+ * @brief Returns a random float between 0 and 1 from this thread's random stream (see Random.h).
+ * @return [0, 1)
  */
 [[nodiscard]] float randomFloat();
 
 /**
- * @brief Returns a random unsigned int between the specified range.
+ * @brief Returns a random unsigned int between the specified range from this thread's random stream (see Random.h).
  * @param min - The minimum number that can be returned.
  * @param max - The maximum number that can be returned.
  * @return [min, max]
  */
 [[nodiscard]] uint32_t randomInt(uint32_t min=0, uint32_t max=1);
 
+/**
+ * @brief Finds the index of the lowest set bit.
+ * @param value - Must not be 0.
+ * @returns The number of zero bits below the lowest set bit.
+ */
+[[nodiscard]] inline int countTrailingZeros(uint32_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(value);
+#endif  // _MSC_VER
+}
+
+/**
+ * @brief Finds the index of the lowest set bit.
+ * @param value - Must not be 0.
+ * @returns The number of zero bits below the lowest set bit.
+ */
+[[nodiscard]] inline int countTrailingZeros(uint64_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif  // _MSC_VER
+}
+
+/**
+ * @returns The number of set bits in value.
+ */
+[[nodiscard]] inline int popCount(uint64_t value)
+{
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(value));
+#else
+    return __builtin_popcountll(value);
+#endif  // _MSC_VER
+}
+
 /**
  * @returns A unique string based on the time and date.
  */
@@ -60,8 +60,8 @@ namespace debug
     /** Clears the log file. */
     void clearLogs();
     
-    /** Gets the logs so that they can be printed elsewhere. */
-    const std::deque<std::string> &getLogs();
+    /** Gets a copy of the logs so that they can be printed elsewhere. */
+    std::deque<std::string> getLogs();
 
     /** Used when a log exception occurs. */
     class LogException
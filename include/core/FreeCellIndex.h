@@ -0,0 +1,127 @@
+/**
+ * @file FreeCellIndex.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "Random.h"
+
+/**
+ * A rank/select bitmap over the empty cells of a grid. One bit per cell plus a running count every 64 cells, so the
+ * k-th empty cell, the next empty cell and uniformly sampling an empty cell don't need to scan past the walls.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class FreeCellIndex
+{
+public:
+    FreeCellIndex() = default;
+    
+    /**
+     * @param cellCount - The number of cells. They all start as walls.
+     */
+    explicit FreeCellIndex(int cellCount);
+    
+    /**
+     * @brief Builds the index in O(cells).
+     * @tparam IsFree - (int cell -> bool)
+     * @param cellCount - The number of cells.
+     * @param isFree - Returns true if the cell is empty.
+     */
+    template<typename IsFree>
+    FreeCellIndex(int cellCount, const IsFree &isFree)
+        : FreeCellIndex(cellCount)
+    {
+        for (int cell = 0; cell < cellCount; ++cell)
+        {
+            if (isFree(cell))
+                mBits[cell >> 6] |= 1ull << (cell & 63);
+        }
+        rebuild();
+    }
+    
+    /**
+     * @brief Marks a cell as empty or not. O(cells / 64) since the counts after the cell need updating.
+     * @param cell - The cell to change. There is no bounds checking.
+     * @param isFree - True if the cell is empty, false if it is a wall.
+     */
+    void set(int cell, bool isFree);
+    
+    /**
+     * @brief Marks many cells as empty or not and then updates the counts once. O(cells / 64 + cells changed).
+     * @param cells - The cells to change. There is no bounds checking.
+     * @param isFree - True if the cells are empty, false if they are walls.
+     */
+    void set(const std::vector<int> &cells, bool isFree);
+    
+    /**
+     * @param cell - The cell to query. There is no bounds checking.
+     * @returns True if the cell is empty.
+     */
+    [[nodiscard]] bool isFree(int cell) const;
+    
+    /**
+     * @returns The total number of empty cells.
+     */
+    [[nodiscard]] int count() const;
+    
+    /**
+     * @param cell - The cell to query [0, cellCount].
+     * @returns The number of empty cells before this cell.
+     */
+    [[nodiscard]] int rank(int cell) const;
+    
+    /**
+     * @param k - Which empty cell you want [0, count()).
+     * @returns The k-th empty cell.
+     */
+    [[nodiscard]] int select(int k) const;
+    
+    /**
+     * @param cell - The cell to start looking from (inclusive).
+     * @returns The first empty cell at or after cell, -1 if there isn't one.
+     */
+    [[nodiscard]] int next(int cell) const;
+    
+    /**
+     * @brief Picks an empty cell where every empty cell is equally likely.
+     * @param rng - The generator to use.
+     * @returns A random empty cell, -1 if there are none.
+     */
+    [[nodiscard]] int sample(RandomStream &rng) const
+    {
+        if (count() == 0)
+            return -1;
+        return select(static_cast<int>(rng.nextBounded(static_cast<uint32_t>(count()))));
+    }
+    
+    /**
+     * @returns The number of bytes used by the index.
+     */
+    [[nodiscard]] uint64_t getMemoryUsage() const;
+
+protected:
+    std::vector<uint64_t> mBits;
+    std::vector<uint32_t> mRanks;          // The number of empty cells before each word. One extra at the end.
+    std::vector<uint32_t> mSelectSamples;  // The word that holds every 64th empty cell.
+    int mCellCount { 0 };
+    
+    /**
+     * @brief Recalculates mRanks and mSelectSamples from mBits.
+     */
+    void rebuild();
+    
+    /**
+     * @brief Recalculates mSelectSamples from mRanks.
+     */
+    void buildSelectSamples();
+};
+
+
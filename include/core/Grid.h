@@ -11,6 +11,11 @@
 #include "Pch.h"
 #endif  // NO_PCH
 
+#include "FreeCellIndex.h"
+
+#include <array>
+#include <deque>
+
 /**
  * Grid holds an array of integers with useful functions to find coords and get adjacent cells.
  * @author Ryan Purse
@@ -21,14 +26,46 @@ class Grid
 public:
     typedef int Cell;
     typedef std::vector<Cell> Cells;
+    typedef std::array<uint8_t, 4> WallDistances;  // [north, east, south, west], capped at maxWallDistance.
     enum class cellType : Cell { Empty, Wall, Start, Finish, OpenSet, ClosedSet, Path };
     
+    /** Wall distances further than this are stored as this. The sensors only tell apart the first few. */
+    static constexpr int maxWallDistance = 255;
+    
+    /**
+     * @brief An entry in the change journal. Every cell in [min, max] may have changed in this version.
+     */
+    struct Change
+    {
+        uint64_t   version;
+        glm::ivec2 min;
+        glm::ivec2 max;
+    };
+    
+    /**
+     * @brief Views of the tables that a grid derives from its cells, one entry per cell. Used to save them to a
+     * cache so that they don't have to be calculated again (see GridCache.h).
+     */
+    struct Tables
+    {
+        const WallDistances *wallDistances;
+        const uint8_t       *moveMasks;
+    };
+
 public:
     /**
      * @param cells - The grid/maze of integers.
      * @param width - The width of the grid/maze
      */
-    Grid(Cells cells, int width);
+    Grid(const Cells &cells, int width);
+    
+    /**
+     * @brief Creates a grid with tables that have already been calculated for these cells. No checks are made.
+     * @param cells - The grid/maze of integers.
+     * @param width - The width of the grid/maze
+     * @param tables - The tables given by getTables() on a grid with the same cells.
+     */
+    Grid(const Cells &cells, int width, const Tables &tables);
     
     ~Grid() = default;
     
@@ -60,6 +97,38 @@ public:
      */
     [[nodiscard]] Cells getSurrounding(Cell cell) const;
     
+    /**
+     * @brief Gets all of the Cells touching this cell including diagonals without allocating.
+     * @param cell - The index to query.
+     * @param out - Where the surrounding cells are written to.
+     * @returns The number of cells written to out.
+     */
+    int getSurrounding(Cell cell, std::array<Cell, 8> &out) const;
+    
+    /**
+     * @brief Gets the legal moves from a cell. Bit i is set if moving in direction i lands on an empty cell, where
+     * the directions are in the same order as action (North, NorthEast, East, ... NorthWest).
+     * Iterate the set bits with countTrailingZeros() and getNeighbour().
+     * @param cell - The cell to query. There is no bounds checking.
+     * @returns A bit mask of the legal moves.
+     */
+    [[nodiscard]] uint8_t getMoveMask(Cell cell) const { return mMoveMasks[cell]; }
+    
+    /**
+     * @brief Checks if moving from the cell in a direction lands on an empty cell.
+     * @param cell - The cell to move from. There is no bounds checking.
+     * @param move - The direction in action order [0, 8).
+     * @returns True if the move is legal, false otherwise.
+     */
+    [[nodiscard]] bool canMove(Cell cell, int move) const { return (mMoveMasks[cell] >> move) & 1u; }
+    
+    /**
+     * @param cell - The cell to move from.
+     * @param move - The direction in action order [0, 8).
+     * @returns The cell next to it in that direction. Only valid if canMove() is true.
+     */
+    [[nodiscard]] Cell getNeighbour(Cell cell, int move) const { return cell + mCellOffsets[move]; }
+    
     /**
      * @brief Gets the Pythagorean distance between a and b.
      * @param a - The Start Cell
@@ -85,11 +154,20 @@ public:
     [[nodiscard]] static Cell getOrthogonalDistance(const glm::ivec2 &a, const glm::ivec2 &b);
     
     /**
-     * @brief Gets the distance to the walls in [x, -x, y, -y] directions.
-     * @param cell - The cell that you want to expand from.
+     * @brief Gets the number of moves between a and b when diagonal moves are allowed. max(∆x, ∆y)
+     * @param a - The start Cell.
+     * @param b - The end Cell.
+     * @returns max(∆x, ∆y)
+     */
+    [[nodiscard]] Cell getDiagonalDistance(Cell a, Cell b) const;
+    
+    /**
+     * @brief Gets the distance to the walls in [x, -x, y, -y] directions. The distances are precomputed, so this is
+     * a single look up. Distances past maxWallDistance are capped to it.
+     * @param cell - The cell that you want to expand from. There is no bounds checking.
      * @returns The distances to each wall [north, east, south, west].
      */
-    [[nodiscard]] Cells getDistanceToOrthogonalWalls(Cell cell) const;
+    [[nodiscard]] const WallDistances &getDistanceToOrthogonalWalls(Cell cell) const;
     
     /**
      * @brief Checks to see if the cell is out of bounds or of type wall.
@@ -113,26 +191,142 @@ public:
     [[nodiscard]] Cell moveToNextValidCell(Cell cell) const;
     
     /**
-     * @returns Returns a const ref to the underlying cells.
+     * @brief Changes the type of a cell and patches anything derived from it.
+     * @param cell - The cell that you want to change. There is no bounds checking.
+     * @param type - The new type of the cell (Empty or Wall).
+     */
+    void setCell(Cell cell, cellType type);
+    
+    /**
+     * @brief Changes the type of many cells as a single edit. The wall distances are only patched once per
+     * row/column and the free cell counts once for the whole edit.
+     * @param cells - The cells that you want to change. There is no bounds checking.
+     * @param type - The new type of the cells (Empty or Wall).
+     */
+    void setCells(const Cells &cells, cellType type);
+    
+    /**
+     * @brief Changes the type of every cell in [min, max] as a single edit.
+     * @param min - The top left of the area (inclusive). Clamped to the grid.
+     * @param max - The bottom right of the area (inclusive). Clamped to the grid.
+     * @param type - The new type of the cells (Empty or Wall).
+     */
+    void fillRect(const glm::ivec2 &min, const glm::ivec2 &max, cellType type);
+    
+    /**
+     * @returns The version of the grid. Every edit increases it by one.
+     */
+    [[nodiscard]] uint64_t getVersion() const;
+    
+    /**
+     * @brief Gets everything that has changed after a version so that derived data can be patched instead of
+     * rebuilt. Changes are in the order that they were made.
+     * @param version - The version that the derived data was last synced to.
+     * @param out - Where the changes are written to. It is cleared first.
+     * @returns False if the journal no longer goes back that far, in which case everything must be rebuilt.
      */
-    [[nodiscard]] const Cells &getCells() const;
+    bool changesSince(uint64_t version, std::vector<Change> &out) const;
     
+    /**
+     * @returns The width and height of the grid.
+     */
+    [[nodiscard]] glm::ivec2 getSize() const;
+    
+    /**
+     * @returns A rank/select index over the empty cells for enumerating or sampling them.
+     */
+    [[nodiscard]] const FreeCellIndex &getFreeCells() const;
+    
+    /**
+     * @returns The number of cells in the grid.
+     */
+    [[nodiscard]] int getCellCount() const;
+    
+    /**
+     * @param cell - The cell that you want to query. There is no bounds checking.
+     * @returns The type of the cell (Empty or Wall).
+     */
+    [[nodiscard]] cellType getCellType(Cell cell) const;
+    
+    /**
+     * @returns Views of the derived tables. Invalidated by any edit.
+     */
+    [[nodiscard]] Tables getTables() const;
+    
+    /**
+     * @returns The number of bytes used by the grid and everything derived from it.
+     */
+    [[nodiscard]] uint64_t getMemoryUsage() const;
+
 protected:
-    Cells mCells;
     int mWidth;
+    int mHeight;
+    int mCellCount;
+    
+    /** The distance to the nearest wall in each orthogonal direction, for every cell. */
+    std::vector<WallDistances> mWallDistances;
+    
+    /**
+     * The cells, one byte each, row-major with a one cell wall border around the outside. Neighbours of a cell are
+     * found by adding a fixed offset, and the border means they never need to be bounds checked.
+     */
+    std::vector<uint8_t> mPadded;
+    
+    /** The offset to each neighbour in mPadded. North, NorthEast, East, ... NorthWest. */
+    std::array<int, 8> mPaddedOffsets {};
+    
+    /** The offset to each neighbour as a Cell index. Same order as mPaddedOffsets. */
+    std::array<Cell, 8> mCellOffsets {};
+    
+    /** Every empty cell. */
+    FreeCellIndex mFreeCells;
+    
+    /** Which of the eight moves are legal from each cell. See getMoveMask(). */
+    std::vector<uint8_t> mMoveMasks;
+    
+    /** Every edit since mJournalStart, oldest first. Capped at journalCapacity entries. */
+    std::deque<Change> mJournal;
+    uint64_t mVersion { 0 };
+    uint64_t mJournalStart { 0 };  // The journal has every change made after this version.
+    
+    static constexpr size_t journalCapacity = 4096;
+    
+    /**
+     * @brief Writes a cell to mPadded and the move masks. Does not touch the free cells or the wall distances.
+     */
+    void writeCell(Cell cell, cellType type);
+    
+    /**
+     * @brief Adds an edit to the journal, dropping the oldest entries if it's full.
+     */
+    void record(const glm::ivec2 &min, const glm::ivec2 &max);
+    
+    /**
+     * @brief Copies the cells into mPadded and builds the free cell index. Shared by the constructors.
+     */
+    void initCells(const Cells &cells);
+    
+    /**
+     * @brief Recalculates the move mask of a single cell from mPadded.
+     */
+    void buildMoveMask(Cell cell);
+    
+    /**
+     * @brief Finds where a cell lives in mPadded. There is no bounds checking.
+     */
+    [[nodiscard]] int paddedIndex(Cell cell) const { return cell + 2 * (cell / mWidth) + mWidth + 3; }
     
     /**
-     * @brief Validates all the cells in a list and returns a new list of valid cells.
-     * @param cells - The Cells that you want to validate.
-     * @returns A valid list of cells.
+     * @brief Recalculates the north and south wall distances for a column with a prefix scan each way.
+     * @param x - The column to recalculate.
      */
-    [[nodiscard]] Cells validateAllCells(const Cells &cells) const;
+    void buildColumnWallDistances(int x);
     
     /**
-     * @brief Checks to see if cell is in bounds. Call verifyCell() first.
-     * @see bool verifyCell(*);
+     * @brief Recalculates the east and west wall distances for a row with a prefix scan each way.
+     * @param y - The row to recalculate.
      */
-    [[nodiscard]] bool isInBounds(Cell cell, const glm::ivec2 &pos) const;
+    void buildRowWallDistances(int y);
 };
 
 
@@ -0,0 +1,138 @@
+/**
+ * @file MazeLoadPipeline.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "Grid.h"
+#include "GridMesh.h"
+
+#include <atomic>
+#include <thread>
+
+/**
+ * Loads a maze on a background thread so that big maps don't freeze the UI. The load runs as a series of stages
+ * (parse the file, build the grid and its tables or load them from the cache, build the mesh) and can be cancelled between any of them.
+ * Nothing that the scene is currently using is touched, so the result can be swapped in all at once when it's ready.\n
+ * Starting a new load never waits for the old one. The old one is cancelled and left to finish its current stage in
+ * the background, and its result is thrown away.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class MazeLoadPipeline
+{
+public:
+    /**
+     * What the pipeline is currently doing.
+     */
+    enum class stage : int { Idle, Parsing, BuildingGrid, BuildingMesh, Finished, Failed, Cancelled };
+    
+    /**
+     * @brief Everything that the scene needs to swap in a new maze.
+     */
+    struct Result
+    {
+        std::shared_ptr<Grid>       grid;
+        std::unique_ptr<GridMesh>   mesh;
+        glm::ivec2                  startPos { 0 };
+        glm::ivec2                  endPos   { 0 };
+        bool                        isFromCache { false };  // True if the grid's tables came from the cache.
+    };
+    
+public:
+    MazeLoadPipeline() = default;
+    
+    /**
+     * @brief Cancels and waits for every load that is still running.
+     */
+    ~MazeLoadPipeline();
+    
+    MazeLoadPipeline(const MazeLoadPipeline &) = delete;
+    MazeLoadPipeline &operator=(const MazeLoadPipeline &) = delete;
+    
+    /**
+     * @brief Starts loading a maze in the background. Any load that is already running is cancelled, but not waited
+     * for, so this never blocks.
+     * @param filePath - A path to where the maze is stored.
+     */
+    void start(std::string_view filePath);
+    
+    /**
+     * @brief Asks the running load to stop. It stops at the end of the stage that it is on.
+     */
+    void cancel();
+    
+    /**
+     * @brief Checks on the load. Must be called from the same thread as start().
+     * @returns The loaded maze once, when it has finished. nullptr otherwise.
+     */
+    [[nodiscard]] std::unique_ptr<Result> poll();
+    
+    /**
+     * @returns True if a load is in progress.
+     */
+    [[nodiscard]] bool isRunning() const;
+    
+    /**
+     * @returns What the pipeline is currently doing.
+     */
+    [[nodiscard]] stage getStage() const;
+    
+    /**
+     * @returns How much of the load has been done [0, 1].
+     */
+    [[nodiscard]] float getProgress() const;
+    
+    /**
+     * @returns A readable name for a stage.
+     */
+    [[nodiscard]] static std::string_view toString(stage loadStage);
+
+protected:
+    /**
+     * @brief A single load and the thread that runs it. Each load has its own state so that a cancelled one can
+     * finish in the background without touching the load that replaced it.
+     */
+    struct Load
+    {
+        std::thread             thread;
+        std::atomic<stage>      loadStage   { stage::Parsing };
+        std::atomic<bool>       isCancelled { false };
+        
+        /** Written by the worker before loadStage is set to Finished. */
+        std::unique_ptr<Result> result;
+    };
+    
+    std::unique_ptr<Load>               mLoad;              // The load whose result will be swapped in.
+    std::vector<std::unique_ptr<Load>>  mCancelledLoads;    // Replaced loads that are still finishing a stage.
+    
+    /**
+     * @brief The body of the worker thread.
+     */
+    static void run(Load &load, std::string filePath);
+    
+    /**
+     * @brief Moves on to the next stage.
+     * @returns False if the load has been cancelled and should stop.
+     */
+    static bool advance(Load &load, stage nextStage);
+    
+    /**
+     * @returns True if the load's worker is still in one of its stages.
+     */
+    [[nodiscard]] static bool isRunning(const Load &load);
+    
+    /**
+     * @brief Joins the cancelled loads that have finished. Never waits on one that is still running.
+     */
+    void joinCancelled();
+};
+
+
@@ -0,0 +1,82 @@
+/**
+ * @file MpscQueue.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include <atomic>
+
+/**
+ * An unbounded, lock-free, multi-producer single-consumer queue (Vyukov style). Any thread may push but only
+ * the owning thread may pop.
+ * @tparam T - The type of item stored. It must be default constructable.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+template<typename T>
+class MpscQueue
+{
+public:
+    MpscQueue()
+    {
+        Node *stub = new Node();
+        mHead.store(stub, std::memory_order_relaxed);
+        mTail = stub;
+    }
+    
+    ~MpscQueue()
+    {
+        T item;
+        while (pop(item));
+        delete mTail;
+    }
+    
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+    
+    /**
+     * @brief Adds an item to the back of the queue. Safe to call from any thread.
+     * @param item - The item that you want to add.
+     */
+    void push(T item)
+    {
+        Node *node = new Node();
+        node->value = std::move(item);
+        Node *previous = mHead.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Removes an item from the front of the queue. Must only be called by the consumer thread.
+     * @param out - Where the item is written to.
+     * @returns True if an item was removed, false if the queue was empty.
+     */
+    bool pop(T &out)
+    {
+        Node *next = mTail->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+            return false;
+        
+        out = std::move(next->value);
+        delete mTail;
+        mTail = next;  // next becomes the new stub.
+        return true;
+    }
+    
+protected:
+    struct Node
+    {
+        std::atomic<Node*> next { nullptr };
+        T value {};
+    };
+    
+    std::atomic<Node*> mHead;  // Producers push here.
+    Node *mTail;               // Only touched by the consumer.
+};
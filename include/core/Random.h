@@ -0,0 +1,126 @@
+/**
+ * @file Random.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include <array>
+#include <cstdint>
+
+/**
+ * A small, fast pseudo random number generator (xoshiro128++). The state is four 32-bit words seeded with
+ * SplitMix64, so any 64-bit seed gives a good starting state. Every master seed has 2^64 streams that are 2^64
+ * numbers apart, so threads given different streams of the same seed never overlap.\n
+ * Also a uniform random bit generator, so it can be used with the standard library where speed doesn't matter.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class RandomStream
+{
+public:
+    typedef uint32_t result_type;
+
+public:
+    /**
+     * @param seed - The master seed. The same seed and stream always give the same numbers.
+     * @param stream - Which of the seed's streams to use. Give each thread its own.
+     */
+    explicit RandomStream(uint64_t seed=0ull, uint64_t stream=0ull);
+    
+    [[nodiscard]] static constexpr result_type min() { return 0u; }
+    [[nodiscard]] static constexpr result_type max() { return 0xFFFFFFFFu; }
+    
+    /**
+     * @returns The next 32 random bits.
+     */
+    result_type operator()()
+    {
+        const uint32_t result = rotateLeft(mState[0] + mState[3], 7) + mState[0];
+        const uint32_t shifted = mState[1] << 9;
+        
+        mState[2] ^= mState[0];
+        mState[3] ^= mState[1];
+        mState[1] ^= mState[2];
+        mState[0] ^= mState[3];
+        mState[2] ^= shifted;
+        mState[3] = rotateLeft(mState[3], 11);
+        
+        return result;
+    }
+    
+    /**
+     * @returns A random float from the top 24 bits, so every value is equally likely. [0, 1)
+     */
+    [[nodiscard]] float nextFloat()
+    {
+        return static_cast<float>((*this)() >> 8) * 0x1.0p-24f;
+    }
+    
+    /**
+     * @brief Multiplies by the range and keeps the top half instead of using modulo or rejection, so it never
+     * branches or divides. Some values are more likely than others by at most range / 2^32.
+     * @param range - The number of values that can be returned. 0 is treated as 2^32.
+     * @returns [0, range)
+     */
+    [[nodiscard]] uint32_t nextBounded(uint32_t range)
+    {
+        const uint64_t wideRange = static_cast<uint64_t>(range - 1u) + 1ull;  // 0 wraps around to 2^32.
+        return static_cast<uint32_t>((static_cast<uint64_t>((*this)()) * wideRange) >> 32);
+    }
+    
+    /**
+     * @returns [min, max]
+     */
+    [[nodiscard]] uint32_t nextInt(uint32_t min, uint32_t max)
+    {
+        return min + nextBounded(max - min + 1u);
+    }
+    
+    /**
+     * @returns 64 random bits, e.g. to seed another generator.
+     */
+    [[nodiscard]] uint64_t nextSeed()
+    {
+        const uint64_t high = (*this)();
+        return (high << 32) | (*this)();
+    }
+    
+    /**
+     * @brief Skips ahead 2^64 numbers. This is how streams are made.
+     */
+    void jump();
+
+protected:
+    std::array<uint32_t, 4> mState {};
+    
+    [[nodiscard]] static constexpr uint32_t rotateLeft(uint32_t value, int count)
+    {
+        return (value << count) | (value >> (32 - count));
+    }
+};
+
+/**
+ * @brief Sets the master seed that every thread's random stream is made from. The calling thread is reseeded as
+ * stream 0 and threads that use randomFloat() or randomInt() for the first time afterwards take streams 1, 2, ...
+ * Threads take their stream in the order they first ask for a number, so workers that need to be reproducible should
+ * be given their own RandomStream instead (see ParallelTrainer).
+ * @param seed - The new master seed.
+ */
+void setRandomSeed(uint64_t seed);
+
+/**
+ * @returns The master seed. Random from the OS unless setRandomSeed() has been called.
+ */
+[[nodiscard]] uint64_t getRandomSeed();
+
+/**
+ * @returns This thread's random stream, used by randomFloat() and randomInt().
+ */
+[[nodiscard]] RandomStream &getRandomStream();
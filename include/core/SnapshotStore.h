@@ -0,0 +1,217 @@
+/**
+ * @file SnapshotStore.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+/**
+ * Versioned, immutable snapshots of a value with one writer and many readers. The writer edits a private working
+ * copy and publishes it as the next version. Readers pin the current version lock-free and keep reading it for as
+ * long as they like. Old versions are freed once no reader has them pinned (hazard pointers), so neither side ever
+ * waits on the other. Copying T should be cheap for this to be worth it (e.g. ChunkedGrid shares its chunks and
+ * only clones the ones that get written to).
+ * @tparam T - The type of value stored. It must be copy constructable.
+ * @tparam readerSlots - The maximum number of snapshots that can be pinned at once.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+template<typename T, size_t readerSlots=64>
+class SnapshotStore
+{
+protected:
+    struct Version
+    {
+        uint64_t number;
+        T        value;
+    };
+    
+    struct alignas(64) Slot  // One per cache line so that readers don't fight over them.
+    {
+        std::atomic<const Version*> pinned { nullptr };
+        std::atomic<bool>           inUse  { false };
+    };
+
+public:
+    /**
+     * A pinned version. The value will not change or be freed until this is destroyed.
+     */
+    class Snapshot
+    {
+    public:
+        Snapshot() = default;
+        
+        Snapshot(Slot *slot, const Version *version)
+            : mSlot(slot), mVersion(version)
+        {
+        }
+        
+        ~Snapshot() { release(); }
+        
+        Snapshot(const Snapshot &) = delete;
+        Snapshot &operator=(const Snapshot &) = delete;
+        
+        Snapshot(Snapshot &&other) noexcept
+            : mSlot(other.mSlot), mVersion(other.mVersion)
+        {
+            other.mSlot = nullptr;
+            other.mVersion = nullptr;
+        }
+        
+        Snapshot &operator=(Snapshot &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                std::swap(mSlot, other.mSlot);
+                std::swap(mVersion, other.mVersion);
+            }
+            return *this;
+        }
+        
+        const T &operator*() const { return mVersion->value; }
+        const T *operator->() const { return &mVersion->value; }
+        explicit operator bool() const { return mVersion != nullptr; }
+        
+        /**
+         * @returns The version number that was pinned.
+         */
+        [[nodiscard]] uint64_t getVersion() const { return mVersion->number; }
+        
+        /**
+         * @brief Unpins the version early.
+         */
+        void release()
+        {
+            if (mSlot == nullptr)
+                return;
+            mSlot->pinned.store(nullptr, std::memory_order_release);
+            mSlot->inUse.store(false, std::memory_order_release);
+            mSlot = nullptr;
+            mVersion = nullptr;
+        }
+    
+    protected:
+        Slot          *mSlot    { nullptr };
+        const Version *mVersion { nullptr };
+    };
+
+public:
+    explicit SnapshotStore(T initial)
+        : mWorking(std::move(initial))
+    {
+        mCurrent.store(new Version{ 0, mWorking }, std::memory_order_release);
+    }
+    
+    ~SnapshotStore()
+    {
+        // Every snapshot must have been released by now.
+        delete mCurrent.load(std::memory_order_acquire);
+        for (const Version *version : mRetired)
+            delete version;
+    }
+    
+    SnapshotStore(const SnapshotStore &) = delete;
+    SnapshotStore &operator=(const SnapshotStore &) = delete;
+    
+    /**
+     * @brief Pins the latest published version. Safe to call from any thread. Only spins if every reader slot is
+     * taken.
+     */
+    Snapshot acquire()
+    {
+        const size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % readerSlots;
+        for (size_t i = start; ; i = (i + 1) % readerSlots)
+        {
+            Slot &slot = mSlots[i];
+            if (slot.inUse.load(std::memory_order_relaxed) || slot.inUse.exchange(true, std::memory_order_acquire))
+            {
+                if ((i + 1) % readerSlots == start)
+                    std::this_thread::yield();
+                continue;
+            }
+            
+            const Version *version = mCurrent.load(std::memory_order_seq_cst);
+            while (true)
+            {
+                // Publish the hazard then check that the version wasn't retired in between.
+                slot.pinned.store(version, std::memory_order_seq_cst);
+                const Version *latest = mCurrent.load(std::memory_order_seq_cst);
+                if (latest == version)
+                    break;
+                version = latest;
+            }
+            return Snapshot(&slot, version);
+        }
+    }
+    
+    /**
+     * @brief The writer's private copy. Changes are not seen by readers until publish() is called. Writer only.
+     */
+    T &edit() { return mWorking; }
+    
+    /**
+     * @brief Makes the working copy the latest version and frees any old versions that are no longer pinned.
+     * Writer only.
+     * @returns The new version number.
+     */
+    uint64_t publish()
+    {
+        const uint64_t number = ++mVersionNumber;
+        const Version *previous = mCurrent.exchange(new Version{ number, mWorking }, std::memory_order_seq_cst);
+        mRetired.push_back(previous);
+        reclaim();
+        return number;
+    }
+    
+    /**
+     * @brief Frees any retired versions that are no longer pinned. Writer only.
+     */
+    void reclaim()
+    {
+        std::array<const Version*, readerSlots> hazards;
+        for (size_t i = 0; i < readerSlots; ++i)
+            hazards[i] = mSlots[i].pinned.load(std::memory_order_seq_cst);
+        
+        auto isPinned = [&hazards](const Version *version) {
+            return std::find(hazards.begin(), hazards.end(), version) != hazards.end();
+        };
+        
+        auto it = std::remove_if(mRetired.begin(), mRetired.end(), [&isPinned](const Version *version) {
+            if (isPinned(version))
+                return false;
+            delete version;
+            return true;
+        });
+        mRetired.erase(it, mRetired.end());
+    }
+    
+    /**
+     * @returns The latest published version number.
+     */
+    [[nodiscard]] uint64_t getVersion() const { return mVersionNumber; }
+    
+    /**
+     * @returns The number of old versions still waiting for readers to let go of them.
+     */
+    [[nodiscard]] size_t getRetiredCount() const { return mRetired.size(); }
+
+protected:
+    std::array<Slot, readerSlots>  mSlots;
+    std::atomic<const Version*>    mCurrent { nullptr };
+    T                              mWorking;
+    uint64_t                       mVersionNumber { 0 };
+    std::vector<const Version*>    mRetired;
+};
+
+
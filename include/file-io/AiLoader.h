@@ -32,6 +32,7 @@ namespace fileSystem
         float explorationRateMin;
         float alpha;  // Learning Rate
         float gamma;  // Discount Factor
+        float lambda { 0.f };  // Trace decay. Older files don't have one, so they use one step Q-learning.
         QTable qTable;
     };
     
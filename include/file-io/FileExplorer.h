@@ -25,8 +25,9 @@ public:
      * @brief Creates a file explorer. Call onSelect to make the file explorer interactive.
      * @param explorerName - A unique Id for ImGui to render it correctly.
      * @param filePath - A path to a folder to all of the items that you want to show.
+     * @param extension - Only show items with this extension (e.g. ".txt"). Everything is shown if empty.
      */
-    FileExplorer(std::string_view explorerName, std::string_view filePath);
+    FileExplorer(std::string_view explorerName, std::string_view filePath, std::string_view extension="");
     
     /**
      * @brief Updates the list of items that are shown.
@@ -49,6 +50,7 @@ protected:
     
     std::string mExplorerName;
     std::string mFilePath;
+    std::string mExtension;
     std::vector<std::string> mPathItems;
     int mIndex { -1 };
 };
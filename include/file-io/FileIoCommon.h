@@ -31,9 +31,10 @@ namespace fileSystem
     /**
      * @brief Lists all items within a given directory.
      * @param path - The path to a directory.
+     * @param extension - Only list items that end with this (e.g. ".txt"). Everything is listed if empty.
      * @returns All items in the given path.
      */
-    [[nodiscard]] std::vector<std::string> ls(std::string_view path);
+    [[nodiscard]] std::vector<std::string> ls(std::string_view path, std::string_view extension="");
     
     /**
      * @brief Validates a path to see if it exists.
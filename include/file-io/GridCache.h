@@ -0,0 +1,55 @@
+/**
+ * @file GridCache.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "Grid.h"
+#include "MazeLoader.h"
+
+namespace fileSystem
+{
+    /**
+     * Increase this whenever anything that Grid derives from its cells changes, so that old caches are ignored.
+     */
+    constexpr uint32_t gridCacheVersion = 3;
+    
+    /**
+     * @brief Hashes the contents of a maze (size and cells) with 64 bit FNV-1a.
+     * @param data - The maze that you want to hash.
+     * @returns The hash of the maze.
+     */
+    [[nodiscard]] uint64_t hashMaze(const MazeData &data);
+    
+    /**
+     * @param mazePath - The path to the maze file.
+     * @returns The path of the cache that sits next to the maze ("<maze>.cache").
+     */
+    [[nodiscard]] std::string getGridCachePath(std::string_view mazePath);
+    
+    /**
+     * @brief Builds a grid from the cache next to the maze file. The tables are checked against the hash of them in
+     * the header before they are used, so a corrupt cache is rebuilt rather than trusted.
+     * @param mazePath - The path to the maze file.
+     * @param data - The maze that was loaded from mazePath.
+     * @returns The grid, or nullptr if there is no cache, it was made from different contents or an older version,
+     * or its tables are corrupt.
+     */
+    [[nodiscard]] std::shared_ptr<Grid> loadGridCache(std::string_view mazePath, const MazeData &data);
+    
+    /**
+     * @brief Saves the tables of a grid to the cache next to the maze file.
+     * @param mazePath - The path to the maze file.
+     * @param data - The maze that was loaded from mazePath.
+     * @param grid - A grid built from data.
+     * @returns True if the cache was written.
+     */
+    bool saveGridCache(std::string_view mazePath, const MazeData &data, const Grid &grid);
+}
@@ -0,0 +1,28 @@
+/**
+ * @file ParallelPathfinding.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+class Grid;
+
+/**
+ * @brief Finds a path between start and end using hash distributed A* (HDA*). Every worker thread owns a
+ * partition of the cells (picked by hashing the cell) and is the only thread that can expand them. Nodes that
+ * belong to another worker are sent to its lock-free inbox. The search ends once no worker has a node that could
+ * beat the best path found so far and no nodes are in flight, so the path returned is optimal.
+ * @param grid - The grid/maze to search. The workers are joined before this returns, so a grid that is only edited
+ * by the calling thread can't change under them. Pass a copy if another thread can edit it.
+ * @param start - The cell that you want to start searching from.
+ * @param end - The cell that you are searching for.
+ * @param threadCount - The number of worker threads. 0 uses the number of hardware threads.
+ * @returns A path between [start, end], nothing if end was not reached.
+ */
+[[nodiscard]] std::vector<int> ParallelAStarGrid(const Grid &grid, int start, int end, unsigned int threadCount=0);
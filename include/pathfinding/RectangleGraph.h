@@ -0,0 +1,156 @@
+/**
+ * @file RectangleGraph.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+class Grid;
+
+/**
+ * A navigation graph that splits the empty cells of a grid into rectangles. Every cell inside a rectangle can reach
+ * every other cell inside it with a straight walk, so the search only needs to expand rectangles rather than cells.
+ * Rectangles that touch (including at a corner) are joined by portals.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class RectangleGraph
+{
+public:
+    /**
+     * @brief An axis aligned box of empty cells. min and max are both inclusive.
+     */
+    struct Rectangle
+    {
+        glm::ivec2 min { 0 };
+        glm::ivec2 max { -1 };
+        bool isAlive { false };
+    };
+    
+    /**
+     * @brief A connection from one rectangle to another. The cells on each side of the portal are stored as boxes
+     * so that a cell can be clamped onto them.
+     */
+    struct Portal
+    {
+        int to { -1 };
+        glm::ivec2 fromMin { 0 };  // The cells in this rectangle that touch the other rectangle.
+        glm::ivec2 fromMax { 0 };
+        glm::ivec2 toMin   { 0 };  // The cells in the other rectangle that touch this one.
+        glm::ivec2 toMax   { 0 };
+    };
+    
+    /**
+     * @brief The size of the graph so that it can be compared against searching the grid directly.
+     */
+    struct Stats
+    {
+        uint64_t nodeCount   { 0 };
+        uint64_t portalCount { 0 };
+        uint64_t cellCount   { 0 };
+        uint64_t memoryBytes { 0 };
+    };
+    
+public:
+    /**
+     * @param grid - The grid/maze that the graph is built from.
+     */
+    explicit RectangleGraph(const Grid &grid);
+    
+    /**
+     * @brief Throws away the current graph and builds it again from scratch.
+     * @param grid - The grid/maze that the graph is built from.
+     */
+    void rebuild(const Grid &grid);
+    
+    /**
+     * @brief Rebuilds only the rectangles that overlap the changed cells. Call after the grid has been edited.
+     * @param grid - The grid/maze after it has been edited. It must be the same size as before.
+     * @param min - The top left of the cells that changed (inclusive).
+     * @param max - The bottom right of the cells that changed (inclusive).
+     */
+    void onCellsChanged(const Grid &grid, const glm::ivec2 &min, const glm::ivec2 &max);
+    
+    /**
+     * @brief Catches up with every edit made to the grid since the last sync, using the grid's change journal.
+     * Falls back to rebuild() if the journal doesn't go back far enough.
+     * @param grid - The grid/maze that this was built from.
+     */
+    void sync(const Grid &grid);
+    
+    /**
+     * @brief Finds the rectangles that need to be walked through to get from start to end.
+     * @param start - The cell that you want to start searching from.
+     * @param end - The cell that you are searching for.
+     * @returns The rectangle ids in order, nothing if end was not reached.
+     */
+    [[nodiscard]] std::vector<int> findRectanglePath(int start, int end) const;
+    
+    /**
+     * @brief Turns a path of rectangles into a path of cells.
+     * @param rectanglePath - The path given by findRectanglePath().
+     * @param start - The cell that the path starts from.
+     * @param end - The cell that the path finishes on.
+     * @returns A path of cells between [start, end].
+     */
+    [[nodiscard]] std::vector<int> refinePath(const std::vector<int> &rectanglePath, int start, int end) const;
+    
+    /**
+     * @brief Searches the graph and refines the result into a path of cells.
+     * @param start - The cell that you want to start searching from.
+     * @param end - The cell that you are searching for.
+     * @returns A path between [start, end], nothing if end was not reached.
+     */
+    [[nodiscard]] std::vector<int> findPath(int start, int end) const;
+    
+    /**
+     * @param cell - The cell that you want to query.
+     * @returns The id of the rectangle that the cell belongs to, -1 if it is a wall or out of bounds.
+     */
+    [[nodiscard]] int getRectangle(int cell) const;
+    
+    /**
+     * @returns A const ref to all rectangles. Dead rectangles are kept so that ids stay stable.
+     */
+    [[nodiscard]] const std::vector<Rectangle> &getRectangles() const;
+    
+    /**
+     * @returns The number of rectangles, portals and the memory that is used by the graph.
+     */
+    [[nodiscard]] Stats getStats() const;
+
+protected:
+    glm::ivec2                          mSize { 0 };
+    std::vector<int>                    mOwners;     // Which rectangle each cell belongs to.
+    std::vector<Rectangle>              mRectangles;
+    std::vector<std::vector<Portal>>    mPortals;    // Indexed by rectangle id.
+    std::vector<int>                    mFreeIds;    // Dead rectangles that can be reused.
+    uint64_t                            mVersion { 0 };  // The grid version that this is synced to.
+    
+    /**
+     * @brief Covers every empty cell in [min, max] that doesn't belong to a rectangle yet with new rectangles.
+     * Rectangles are grown to the right first and then downwards for as long as possible.
+     * @returns The ids of the rectangles that were created.
+     */
+    std::vector<int> decompose(const Grid &grid, const glm::ivec2 &min, const glm::ivec2 &max);
+    
+    /**
+     * @brief Creates portals between the rectangle and every rectangle that touches it.
+     */
+    void connect(int id);
+    
+    /**
+     * @brief Removes a rectangle and every portal that leads to it.
+     */
+    void removeRectangle(int id);
+    
+    [[nodiscard]] bool isInBounds(const glm::ivec2 &pos) const;
+};
+
+
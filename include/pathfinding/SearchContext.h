@@ -0,0 +1,118 @@
+/**
+ * @file SearchContext.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "Pathfinding.h"
+
+class Grid;
+class ClearanceMap;
+
+/**
+ * Owns all of the memory that A* needs (open set, scores, where each cell came from and the output path) so that it
+ * can be reused between queries. Scores are stamped with a generation number which makes resetting O(1). Once the
+ * buffers have grown to fit the grid, queries do not allocate.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class SearchContext
+{
+public:
+    /**
+     * @brief Information about how the context has been used. Used to verify that queries don't allocate.
+     */
+    struct Stats
+    {
+        uint64_t queries      { 0 };
+        uint64_t allocations  { 0 };  // The number of times any of the buffers had to grow.
+        uint64_t expanded     { 0 };  // The number of cells taken from the open set in total.
+    };
+    
+public:
+    SearchContext() = default;
+    
+    /**
+     * @param cellCount - The number of cells in the largest grid that will be searched. Reserves everything upfront.
+     */
+    explicit SearchContext(size_t cellCount);
+    
+    /**
+     * @brief Finds and creates a path of cells between start and end. Uses max(∆x, ∆y) as the heuristic.
+     * @param grid - The grid/maze to search.
+     * @param start - The cell that you want to start searching from.
+     * @param end - The cell that you are searching for.
+     * @returns A path between [start, end], nothing if end was not reached. The path is owned by the context
+     * and is only valid until the next search.
+     */
+    const std::vector<int> &findPath(const Grid &grid, int start, int end);
+    
+    /**
+     * @brief Identical to findPath() but for agents bigger than a single cell. Cells that the agent doesn't fit in
+     * are pruned with a single look up into the clearance map.
+     * @param grid - The grid/maze to search.
+     * @param clearance - The clearance map built from the grid.
+     * @param radius - The radius of the agent in cells. 0 is a single cell.
+     * @param start - The cell that you want to start searching from.
+     * @param end - The cell that you are searching for.
+     * @returns A path between [start, end], nothing if end was not reached. The path is owned by the context
+     * and is only valid until the next search.
+     */
+    const std::vector<int> &findPath(const Grid &grid, const ClearanceMap &clearance, int radius, int start, int end);
+    
+    /**
+     * @brief Makes every cell unvisited again. O(1) unless the generation counter wraps around.
+     */
+    void reset();
+    
+    /**
+     * @returns The path found by the last search.
+     */
+    [[nodiscard]] const std::vector<int> &getPath() const;
+    
+    /**
+     * @returns The number of queries, allocations and expansions since the context was created.
+     */
+    [[nodiscard]] const Stats &getStats() const;
+
+protected:
+    std::vector<float>          mGScore;
+    std::vector<int>            mCameFrom;
+    std::vector<uint32_t>       mGeneration;  // A cell's scores are only valid when it matches mCurrentGeneration.
+    std::vector<FNode<int>>     mOpenSet;     // A binary heap ordered by FNode::operator<.
+    std::vector<int>            mPath;
+    uint32_t                    mCurrentGeneration { 1 };
+    Stats                       mStats;
+    
+    /**
+     * @brief The A* search shared by each findPath().
+     * @param isPassable - (int cell -> bool) Returns true if the cell can be stepped on.
+     */
+    template<typename Passable>
+    const std::vector<int> &search(const Grid &grid, int start, int end, const Passable &isPassable);
+    
+    /**
+     * @brief Makes sure that the per cell buffers can hold every cell in the grid.
+     */
+    void reserve(size_t cellCount);
+    
+    /**
+     * @brief Pushes onto the buffer, counting the allocation if it needs to grow.
+     */
+    template<typename T>
+    void pushBack(std::vector<T> &buffer, const T &item)
+    {
+        if (buffer.size() == buffer.capacity())
+            mStats.allocations++;
+        buffer.push_back(item);
+    }
+};
+
+
@@ -13,15 +13,17 @@
 
 #include "QlHelpers.h"
 #include "AiLoader.h"
+#include "ReplayBuffer.h"
+#include "EligibilityTraces.h"
+#include "DynaModel.h"
 
-#include <map>
 #include <random>
 
 /**
  * Performs actions based on the environment it is in. Uses a Q-Table to help decided what is should do.
  * Can be trained to an environment.\n
  * The Q-Table consists of states and actions. An action can either be go in any of the eight directions.
- * A states is defined by the string "XYNESW" where,\n
+ * A states is packed into an integer (see State) from "XYNESW" where,\n
  * - X is the horizontal direction to the goal (0-No distance, 1-To the left, 2-To the right),\n
  * - Y is the vertical direction to the goal (0-No distance, 1-Above, 2-Below),\n
  * - NESW are the distances to each wall in the corresponding direction (1-One away, 2-Two away, 3-Three away, 4-Four+ away).\n
@@ -31,7 +33,7 @@
 class Agent
 {
 public:
-    Agent();
+    Agent() = default;
     ~Agent() = default;
     
     /**
@@ -39,14 +41,14 @@ public:
      * @param state - The state that the agent is currently in.
      * @returns The new position of the agent.
      */
-    glm::ivec2 performAction(const State &state);
+    glm::ivec2 performAction(State state);
     
     /**
      * @brief Let the agent perform an action based on the given state.
      * @param state - The state that the agent is currently in.
      * @returns The new position of the agent.
      */
-    glm::ivec2 performTrainingAction(const State &state);
+    glm::ivec2 performTrainingAction(State state);
     
     /**
      * @brief Goes back to the previous position.
@@ -54,12 +56,22 @@ public:
     void undoAction();
     
     /**
-     * @brief Gives a reward to the agent.
+     * @brief Gives a reward to the agent. Uses Q(lambda) if lambda > 0. If experience replay is on, the step is also
+     * stored and replayed later.
      * @param points - How many points you want to give (can be negative).
      * @param currState - Where the agent is.
      * @param nextState - Where the agent went to.
      */
-    void reward(float points, const State &currState, const State &nextState);
+    void reward(float points, State currState, State nextState);
+    
+    /**
+     * @brief Teaches the Dyna-Q model what the last action did and makes the planning updates. Call it once per real
+     * step, since a step can give more than one reward (e.g. walking into a wall).
+     * @param points - The reward for the step.
+     * @param currState - Where the agent was.
+     * @param nextState - Where the agent ended up.
+     */
+    void plan(float points, State currState, State nextState);
     
     /**
      * @brief Allows ImGui to show and configure the stats of the Agent.
@@ -98,41 +110,128 @@ public:
      * @brief Gets the position of the agent.
      */
     [[nodiscard]] const glm::ivec2 &getPosition() const;
+    
+    /**
+     * @brief Gets the position the agent was in before it performed its last action.
+     */
+    [[nodiscard]] glm::ivec2 getPreviousPosition() const;
+    
+    /**
+     * @brief Gets the last action that the agent performed.
+     */
+    [[nodiscard]] action getAction() const;
+    
+    /**
+     * @brief Gets the Q-Table that the agent uses to make decisions.
+     */
+    [[nodiscard]] const QTable &getQTable() const;
+    
+    /**
+     * @brief Replaces the Q-Table, e.g. with one trained elsewhere.
+     */
+    void setQTable(const QTable &qTable);
+    
+    /**
+     * @brief Gets the learning rate (alpha).
+     */
+    [[nodiscard]] float getLearningRate() const;
+    
+    /**
+     * @brief Gets the discount factor (gamma).
+     */
+    [[nodiscard]] float getDiscountFactor() const;
+    
+    /**
+     * @brief Gets the lowest that the exploration rate can go.
+     */
+    [[nodiscard]] float getMinExplorationRate() const;
+    
+    /**
+     * @brief Gets how much the Q-Table has changed since resetChanges() was last called.
+     */
+    [[nodiscard]] const QChanges &getChanges() const;
+    
+    /**
+     * @brief Starts counting changes to the Q-Table again, e.g. at the start of an episode.
+     */
+    void resetChanges();
+    
+    /**
+     * @brief Gets how far back credit reaches with eligibility traces (lambda). 0 is one step Q-learning.
+     */
+    [[nodiscard]] float getTraceDecay() const;
+    
+    /**
+     * @brief Sets how far back credit reaches with eligibility traces (lambda) [0, 1].
+     */
+    void setTraceDecay(float traceDecay);
+    
+    /**
+     * @brief Removes every eligibility trace. Needs to be called at the start of each training episode.
+     */
+    void clearTraces();
+    
+    /**
+     * @brief Replaces the experience replay buffer. Any stored transitions are lost.
+     * @param settings - The size of the buffer and how it's sampled. A capacity of 0 turns replay off.
+     */
+    void setReplaySettings(const ReplayBuffer::Settings &settings);
+    
+    /**
+     * @brief Gets the experience replay buffer.
+     */
+    [[nodiscard]] const ReplayBuffer &getReplayBuffer() const;
+    
+    /**
+     * @brief Removes every transition from the experience replay buffer, e.g. when starting a new Ai.
+     */
+    void clearReplay();
+    
+    /**
+     * @brief Gets the number of Dyna-Q planning updates made after each real step. 0 means Dyna-Q is off.
+     */
+    [[nodiscard]] int getPlanningSteps() const;
+    
+    /**
+     * @brief Sets the number of Dyna-Q planning updates made after each real step. 0 turns Dyna-Q off.
+     */
+    void setPlanningSteps(int steps);
+    
+    [[nodiscard]] const DynaModel &getModel() const;
+    
+    /**
+     * @brief Forgets everything the Dyna-Q model has learned, e.g. when starting a new Ai.
+     */
+    void clearModel();
 
 protected:
-    QTable     mQTable;
-    glm::ivec2 mPosition            { 0 };
-    action     mAction              { action::North };
-    float      mExplorationRate     { 0.8f };
-    float      mMinExplorationRate  { 0.001f };
-    float      alpha                { 0.2f };  // The learning rate.
-    float      gamma                { 0.9f };  // Discount factor.
-    
-    // What the agent should do based on the action is chose.
-    const std::unordered_map<action, glm::ivec2> mActionTable {
-            { action::North,        glm::ivec2( 0, -1) },
-            { action::NorthEast,    glm::ivec2( 1, -1) },
-            { action::East,         glm::ivec2( 1,  0) },
-            { action::SouthEast,    glm::ivec2( 1,  1) },
-            { action::South,        glm::ivec2( 0,  1) },
-            { action::SouthWest,    glm::ivec2(-1,  1) },
-            { action::West,         glm::ivec2(-1,  0) },
-            { action::NorthWest,    glm::ivec2(-1, -1) },
-    };
+    QTable            mQTable;
+    ReplayBuffer      mReplay;
+    EligibilityTraces mTraces;
+    DynaModel         mModel;
+    QChanges          mChanges;
+    glm::ivec2        mPosition            { 0 };
+    action            mAction              { action::North };
+    float             mExplorationRate     { 0.8f };
+    float             mMinExplorationRate  { 0.001f };
+    float             alpha                { 0.2f };  // The learning rate.
+    float             gamma                { 0.9f };  // Discount factor.
+    float             lambda               { 0.f };   // Trace decay. 0 turns eligibility traces off.
+    int               mPlanningSteps       { 0 };     // Dyna-Q updates per real step. 0 turns Dyna-Q off.
     
     /**
      * @brief Chooses an action to perform based on the Q-Table and the exploration rate.
      * @param state - The state that the Agent is currently in.
      * @returns The action that the agent decided to perform.
      */
-    [[nodiscard]] action chooseAction(const State &state) const;
+    [[nodiscard]] action chooseAction(State state) const;
     
     /**
      * @brief Looks at the Q-Table and performs the best option based on the state.
      * @param state - The state that the agent in currently in.
      * @returns The action that the agent decided to perform.
      */
-    [[nodiscard]] action exploit(const State &state) const;
+    [[nodiscard]] action exploit(State state) const;
     
     /**
      * @brief Randomly chooses and action to perform.
@@ -145,7 +244,7 @@ protected:
      * @param nextState - the state that you want to look at.
      * @returns maximum value in next state.
      */
-    float getMaxInNextState(const State &nextState);
+    float getMaxInNextState(State nextState);
 };
 
 
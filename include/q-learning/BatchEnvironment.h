@@ -0,0 +1,135 @@
+/**
+ * @file BatchEnvironment.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "QlHelpers.h"
+#include "Environment.h"
+#include "Random.h"
+
+class Grid;
+
+/**
+ * Steps thousands of agents at once. Everything about the agents is stored as structure-of-arrays and each part of
+ * a step (sensors, acting, wall checks, rewards) is its own flat loop over every agent, so the loops stay in cache
+ * and can be vectorised. Q-Table updates are applied as a batch once every agent has stepped. Agents that reach
+ * their goal or run out of iterations start a new episode between random empty cells straight away.\n
+ * The rewards and updates match QlPathFinder::updateTrain() with traces, replay and Dyna-Q off. Walking into a wall
+ * is updated twice, once with intoWall and once with awayFromGoal.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class BatchEnvironment
+{
+public:
+    struct Settings
+    {
+        int      agentCount         { 1024 };
+        uint64_t episodes           { 10'000ull };
+        uint64_t iterationMax       { 500ull };
+        float    alpha              { 0.2f };
+        float    gamma              { 0.9f };
+        float    minExplorationRate { 0.001f };
+    };
+    
+    struct Stats
+    {
+        uint64_t episodes       { 0 };
+        uint64_t successes      { 0 };  // Episodes that reached the goal.
+        uint64_t steps          { 0 };  // Agent steps, not batch steps.
+        double   seconds        { 0.0 };
+        double   stepsPerSecond { 0.0 };
+    };
+
+public:
+    /**
+     * @param grid - The grid/maze that every agent is in. It must have at least one empty cell.
+     * @param rewards - The rewards given to every agent.
+     * @param agentCount - The number of agents that are stepped together.
+     * @param seed - Seeds the random start/goal cells and exploration.
+     */
+    BatchEnvironment(std::shared_ptr<Grid> grid, const Rewards &rewards, int agentCount, uint64_t seed=1ull);
+    
+    /**
+     * @brief Starts a new episode for every agent.
+     */
+    void resetAll();
+    
+    /**
+     * @brief Picks an epsilon-greedy action for every agent.
+     * @param qTable - The table to act on.
+     * @param explorationRate - The chance of picking a random action [0, 1].
+     */
+    void chooseActions(const QTable &qTable, float explorationRate);
+    
+    /**
+     * @brief Moves every agent by its chosen action and works out its reward and next state.
+     */
+    void step();
+    
+    /**
+     * @brief Applies the Bellman update for every agent's last step. Agents that walked into a wall get two.
+     */
+    void applyUpdates(QTable &qTable, float alpha, float gamma) const;
+    
+    /**
+     * @brief Starts new episodes for the agents that reached their goal or ran out of iterations.
+     * @param iterationMax - The most steps an episode can take.
+     * @param stats - Finished episodes are counted here.
+     */
+    void restartFinished(uint64_t iterationMax, Stats &stats);
+    
+    /**
+     * @brief Trains a table by running the steps above in a loop until enough episodes have finished. Uses the
+     * same exploration schedule as QlPathFinder.
+     * @param qTable - The table to train. Training continues from the values already in it.
+     * @param settings - How long to train for and the learning rates. agentCount is ignored.
+     * @returns How fast training went.
+     */
+    Stats train(QTable &qTable, const Settings &settings);
+    
+    /**
+     * @returns The number of agents.
+     */
+    [[nodiscard]] int getAgentCount() const;
+
+protected:
+    std::shared_ptr<Grid> mGrid;
+    Rewards               mRewards;
+    int                   mAgentCount;
+    int                   mWidth;
+    RandomStream          mRandom;
+    
+    // Per cell sensor caches.
+    std::vector<uint8_t>  mWallRanks;
+    
+    // Per agent, structure-of-arrays.
+    std::vector<int>      mCells;
+    std::vector<int>      mX;
+    std::vector<int>      mY;
+    std::vector<int>      mGoalX;
+    std::vector<int>      mGoalY;
+    std::vector<int>      mLastDistances;  // Squared, so that no square roots are needed to compare them.
+    std::vector<State>    mStates;
+    std::vector<State>    mNextStates;
+    std::vector<uint8_t>  mActions;
+    std::vector<uint8_t>  mCanMove;        // 0 if the last action walked into a wall.
+    std::vector<float>    mRewardValues;
+    std::vector<uint8_t>  mIsAtGoal;
+    std::vector<uint32_t> mIterations;
+    
+    /**
+     * @brief Starts a new episode for a single agent.
+     */
+    void resetAgent(int agent);
+};
+
+
@@ -0,0 +1,149 @@
+/**
+ * @file ConvergenceTracker.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "QlHelpers.h"
+#include "Environment.h"
+
+class Grid;
+
+/**
+ * Watches a training run to see if the Ai has stopped improving so that training can end early. Tracks how much the
+ * Q-Table changes each episode (max and mean |deltaQ|), the success rate over a sliding window of episodes and,
+ * every so often, how well the greedy policy does between a fixed set of start and goal cells. The greedy
+ * evaluations run every evaluationInterval episodes whether or not early stopping is on, and each one costs about
+ * as much as an episode per pair. The fixed evaluation pairs are sampled with their own seed, so training can visit
+ * them too. They measure the same pairs over time rather than how well the policy generalises.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class ConvergenceTracker
+{
+public:
+    enum class stopReason
+            : unsigned char {
+        None, EpisodeLimit, QConverged, SuccessWindow, EvaluationTarget, EvaluationPlateau
+    };
+    
+    struct Settings
+    {
+        bool     isEnabled              { false };  // Lets training stop early. Evaluations run either way.
+        uint64_t minEpisodes            { 500 };    // Training can't stop early before this many episodes.
+        float    deltaThreshold         { 0.001f }; // Converged once every episode's max |deltaQ| is below this...
+        uint64_t deltaPatience          { 200 };    // ...for this many episodes in a row. 0 turns it off.
+        uint64_t successWindow          { 200 };    // Episodes in the sliding success window.
+        float    successThreshold       { 1.1f };   // Stop once the window's success rate reaches this. > 1 is off.
+        uint64_t evaluationInterval     { 500 };    // Episodes between greedy evaluations. 0 turns them off.
+        int      evaluationCount        { 200 };    // Fixed start and goal pairs per evaluation.
+        float    evaluationTarget       { 1.f };    // Stop once the greedy success rate reaches this.
+        int      evaluationPatience     { 5 };      // Stop after this many evaluations without a new best. 0 is off.
+    };
+    
+    struct Evaluation
+    {
+        float successRate   { 0.f };  // Greedy episodes that reached the goal.
+        float meanSteps     { 0.f };  // Mean length of the successful greedy episodes.
+    };
+    
+    struct Stats
+    {
+        uint64_t   episodes             { 0 };
+        float      lastMaxDelta         { 0.f };
+        float      lastMeanDelta        { 0.f };
+        float      windowSuccessRate    { 0.f };
+        Evaluation lastEvaluation;
+        Evaluation bestEvaluation;
+        uint64_t   evaluations          { 0 };
+        stopReason reason               { stopReason::None };
+    };
+    
+    typedef std::vector<std::pair<glm::ivec2, glm::ivec2>> Pairs;
+    
+    static constexpr uint32_t evaluationSeed = 12345u;  // Fixed so that every table is evaluated on the same pairs.
+
+public:
+    /**
+     * @brief Starts tracking a new training run.
+     * @param grid - The grid that is being trained on. The fixed evaluation pairs are picked from it.
+     * @param settings - When to stop early.
+     */
+    void reset(const Grid &grid, const Settings &settings);
+    
+    /**
+     * @brief Finishes an episode, evaluating the greedy policy if it's time to and checking if training should stop.
+     * @param isSuccess - True if the episode reached the goal.
+     * @param changes - How much the agent changed the Q-Table during the episode, counting every update.
+     * @param qTable - The table being trained.
+     * @param environment - The environment being trained in (borrowed for evaluation).
+     * @param iterationMax - The most steps an evaluation episode can take.
+     */
+    void endEpisode(bool isSuccess, const QChanges &changes, const QTable &qTable,
+                    Environment &environment, uint64_t iterationMax);
+    
+    /**
+     * @brief Records that training ran for its whole budget without stopping early.
+     */
+    void finish();
+    
+    /**
+     * @returns True if training has converged and early stopping is on.
+     */
+    [[nodiscard]] bool shouldStop() const;
+    
+    [[nodiscard]] const Stats &getStats() const;
+    [[nodiscard]] const Settings &getSettings() const;
+    
+    /**
+     * @brief Changes when to stop early. A new successWindow keeps the latest results that still fit in it.
+     */
+    void setSettings(const Settings &settings);
+    
+    /**
+     * @returns A human readable reason.
+     */
+    [[nodiscard]] static std::string_view toString(stopReason reason);
+    
+    /**
+     * @brief Picks random start and goal cells with a fixed seed so that every call gives the same pairs.
+     * @param grid - The grid to pick empty cells from.
+     * @param count - The number of pairs.
+     * @param seed - The seed for the random cells.
+     */
+    [[nodiscard]] static Pairs makeEvaluationPairs(const Grid &grid, int count, uint32_t seed);
+    
+    /**
+     * @brief Runs the greedy policy between each pair. The agent is stopped by walls rather than penalised.
+     * @param qTable - The table to evaluate.
+     * @param environment - The environment to evaluate in. Borrowed rather than copied so that its wall ranks
+     * aren't copied during training. Its goal is put back afterwards.
+     * @param pairs - Start and goal cells.
+     * @param iterationMax - The most steps that each episode can take.
+     */
+    [[nodiscard]] static Evaluation evaluate(const QTable &qTable, Environment &environment, const Pairs &pairs,
+                                             uint64_t iterationMax);
+
+protected:
+    Settings          mSettings;
+    Stats             mStats;
+    Pairs             mEvaluationPairs;
+    std::vector<bool> mWindow;                      // Ring buffer of the latest episode results.
+    size_t            mWindowNext           { 0 };
+    uint64_t          mWindowCount          { 0 };  // Results in the window, up to its size.
+    uint64_t          mWindowSuccesses      { 0 };
+    uint64_t          mCalmEpisodes         { 0 };  // Episodes in a row with a max |deltaQ| below the threshold.
+    int               mEvaluationsSinceBest { 0 };
+    
+    /**
+     * @returns The reason training should stop, or None if it should carry on.
+     */
+    [[nodiscard]] stopReason checkStop() const;
+};
@@ -0,0 +1,59 @@
+/**
+ * @file DynaModel.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "QlHelpers.h"
+
+/**
+ * The learned model for Dyna-Q. Remembers the last reward and next state seen for every state-action pair the agent
+ * has taken, and replays random ones as simulated steps between real ones. Planning steps only touch the Q-Table and
+ * this model, so they are much cheaper than a real step and let the Q-Table catch up with what the agent has seen.\n
+ * The model is a flat table indexed by state * action::Count + action plus a list of the pairs that have been seen,
+ * so sampling a pair is a single random index.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class DynaModel
+{
+public:
+    DynaModel();
+    
+    /**
+     * @brief Records what happened after taking an action. Overwrites what was seen before for the same pair.
+     */
+    void observe(State state, action agentAction, float reward, State nextState);
+    
+    /**
+     * @brief Performs simulated Q-learning updates from random pairs that have been seen.
+     * @param qTable - The table to update.
+     * @param steps - The number of simulated updates.
+     * @param alpha - The learning rate.
+     * @param gamma - The discount factor.
+     * @returns How much the simulated updates changed.
+     */
+    QChanges plan(QTable &qTable, int steps, float alpha, float gamma) const;
+    
+    /** Forgets everything the model has seen. */
+    void clear();
+    
+    /**
+     * @returns The number of state-action pairs that have been seen.
+     */
+    [[nodiscard]] size_t getSeenCount() const;
+
+protected:
+    static constexpr State unseen = 0xFFFF;
+    
+    std::vector<float>    mRewards;
+    std::vector<State>    mNextStates;  // unseen if the pair hasn't been taken yet.
+    std::vector<uint16_t> mSeen;        // Every pair with a next state, in the order they were first seen.
+};
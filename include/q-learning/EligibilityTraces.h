@@ -0,0 +1,59 @@
+/**
+ * @file EligibilityTraces.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "QlHelpers.h"
+
+/**
+ * Watkins's Q(lambda). Every state-action pair visited this episode keeps a trace that decays by gamma * lambda each
+ * step, and each temporal difference error is applied to all of them at once so that the reward at the goal reaches
+ * back along the whole path instead of one step per episode. Traces are cut whenever the agent explores since the
+ * steps before it no longer lead greedily to what happens next.\n
+ * Only the pairs with a trace are kept in an active list, so an update costs the length of the recent path rather
+ * than a sweep of the whole Q-Table. Traces that decay below a threshold are dropped from the list.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class EligibilityTraces
+{
+public:
+    EligibilityTraces();
+    
+    /**
+     * @brief Applies one step of Watkins's Q(lambda) to the table.
+     * @param qTable - The table to update.
+     * @param state - The state that the agent was in.
+     * @param agentAction - The action that the agent took.
+     * @param points - The reward for the action.
+     * @param nextState - The state that the agent ended up in.
+     * @param alpha - The learning rate.
+     * @param gamma - The discount factor.
+     * @param lambda - How far back credit reaches [0, 1]. 0 is the same as one step Q-learning.
+     * @returns How much every pair with a trace changed.
+     */
+    QChanges update(QTable &qTable, State state, action agentAction, float points, State nextState,
+                float alpha, float gamma, float lambda);
+    
+    /** Removes every trace, e.g. at the start of an episode. */
+    void clear();
+    
+    /**
+     * @returns The number of state-action pairs with a trace.
+     */
+    [[nodiscard]] size_t getActiveCount() const;
+    
+    static constexpr float traceThreshold = 0.01f;  // Traces smaller than this are dropped.
+
+protected:
+    std::vector<float>    mTraces;  // Dense so that a pair can be looked up. Only mActive is ever swept.
+    std::vector<uint16_t> mActive;  // state * action::Count + action for each pair with a trace.
+};
@@ -34,7 +34,7 @@ class Environment
 {
 public:
     /** @brief The current state that was processed by the environment. */
-    State                   state;
+    State                   state { 0 };
     
     /** @brief The 'real' environment that the virtual environment is working on. */
     std::shared_ptr<Grid>   grid;
@@ -67,9 +67,30 @@ public:
      * Additionally checks to see if the agent has reached the finish.
      * @param agent - The agent that you want to reward.
      * @param nextState - The next state the agent will be in.
+     * @param points - Set to the reward that was given.
      * @returns True if the agent has reached the finish, false otherwise.
      */
-    bool reward(Agent &agent, const State &nextState);
+    bool reward(Agent &agent, State nextState, float &points);
+    
+    /**
+     * @brief Works out the reward for moving to a position without giving it to anyone. Used by trainers that
+     * update a Q-Table directly.
+     * @param agentPosition - Where the agent moved to.
+     * @param isAtGoal - Set to true if the position is the goal.
+     * @returns The reward.
+     */
+    float calculateReward(const glm::ivec2 &agentPosition, bool &isAtGoal);
+    
+    /**
+     * @brief Resets the distance used to tell if an agent moved towards the goal. Call at the start of an episode.
+     * @param agentPosition - Where the agent starts.
+     */
+    void resetDistance(const glm::ivec2 &agentPosition);
+    
+    /**
+     * @returns The rewards that are given to the agent.
+     */
+    [[nodiscard]] const Rewards &getRewards() const;
     
     /**
      * @brief Allows ImGui to render and change the variables within the environment.
@@ -92,19 +113,30 @@ protected:
     float   mAgentsLastDistance { 0.f };
     Rewards mRewards;
     
+    /** The packed wall distance ranks of every cell, so a step only reads one byte. See getWallDistances(). */
+    std::vector<uint8_t>    mWallRanks;
+    std::weak_ptr<Grid>     mWallRanksGrid;  // Holding the control block stops a new grid from reusing it.
+    uint64_t                mWallRanksVersion   { 0 };
+    
+    /**
+     * @brief Rebuilds mWallRanks if the grid has been replaced or edited since it was last built.
+     */
+    void updateWallRanks();
+    
     /**
      * @brief Gets the direction to the goal based on the agent position.
      * @param agentPosition - The agents position you want to compare it to.
-     * @returns The direction to the goal "XY". 0 - No Direction, 1 - Up/Left, 2 - Down/Right.
+     * @returns The direction to the goal X * 3 + Y. 0 - No Direction, 1 - Up/Left, 2 - Down/Right.
      */
-    [[nodiscard]] std::string getGoalDirection(const glm::ivec2 &agentPosition) const;
+    [[nodiscard]] int getGoalDirection(const glm::ivec2 &agentPosition) const;
     
     /**
      * @brief Gets the distance to each of the orthogonal walls.
      * @param agentPosition - The agents position you want to compare it to.
-     * @returns The distance to each wall "NESW". 1 - One Away, 2 - Two Away, 3 - Three Away, 4 - Four+ Away.
+     * @returns The rank of the distance to each wall packed as N * 64 + E * 16 + S * 4 + W.
+     * 0 - One Away, 1 - Two Away, 2 - Three Away, 3 - Four+ Away.
      */
-    [[nodiscard]] std::string getWallDistances(const glm::ivec2 &agentPosition) const;
+    [[nodiscard]] int getWallDistances(const glm::ivec2 &agentPosition) const;
 };
 
 
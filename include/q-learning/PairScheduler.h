@@ -0,0 +1,107 @@
+/**
+ * @file PairScheduler.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+class Grid;
+
+/**
+ * Picks the start and goal cells for each training episode as a curriculum. Pairs are found with a breadth first
+ * search from a spread of start cells, so every pair's difficulty is the number of agent steps between them. The
+ * pairs are grouped by that distance and only the shortest are handed out at first. Longer pairs are unlocked as
+ * training goes on until every pair can be picked.\n
+ * Within what's unlocked, pairs are picked in proportion to how often they've failed recently (ran out of
+ * iterations before reaching the goal), so the Ai keeps practicing what it can't do yet. Pairs that haven't been
+ * tried count as failing.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class PairScheduler
+{
+public:
+    struct Settings
+    {
+        bool  isEnabled         { false };
+        int   startCount        { 256 };   // Most start cells to search from. Spread evenly over the empty cells.
+        int   goalsPerStart     { 64 };    // Most goals kept per start. Spread evenly over the distances.
+        int   bucketCount       { 16 };    // Distance groups that are unlocked one at a time.
+        float initialFraction   { 0.1f };  // Fraction of the distance groups unlocked at the start.
+        float rampFraction      { 0.5f };  // Fraction of the episodes it takes to unlock every group.
+        float failureBoost      { 4.f };   // A pair that always fails is picked this much more than one that doesn't.
+        float failureRate       { 0.5f };  // How much the latest episode counts towards a pair's failure score.
+    };
+    
+    struct Pair
+    {
+        int   start;
+        int   goal;
+        int   distance;  // Agent steps from start to goal.
+        float failure;   // Recent failure score [0, 1].
+    };
+
+public:
+    /**
+     * @brief Finds every pair to pick from. Nothing is searched if the scheduler is turned off.
+     * @param grid - The grid that is being trained on.
+     * @param settings - How the pairs are found and picked.
+     */
+    void reset(const Grid &grid, const Settings &settings);
+    
+    /**
+     * @brief Picks the pair for the next episode.
+     * @param progress - How far through training it is [0, 1]. Decides which distances are unlocked.
+     * @returns The pair to train on. Must not be called if there are no pairs.
+     */
+    [[nodiscard]] const Pair &next(float progress);
+    
+    /**
+     * @brief Records how the last pair from next() went.
+     * @param isSuccess - True if the episode reached the goal.
+     */
+    void report(bool isSuccess);
+    
+    [[nodiscard]] const Settings &getSettings() const;
+    
+    /**
+     * @brief Changes how pairs are picked without searching for the pairs again. Use reset() if the pairs need
+     * to change (including the bucket count).
+     */
+    void setSettings(const Settings &settings);
+    
+    /**
+     * @returns True if it's turned on and has pairs to pick from.
+     */
+    [[nodiscard]] bool isActive() const;
+    
+    [[nodiscard]] size_t getPairCount() const;
+    
+    /**
+     * @returns The longest distance that can be picked at the moment.
+     */
+    [[nodiscard]] int getUnlockedDistance() const;
+
+protected:
+    Settings            mSettings;
+    std::vector<Pair>   mPairs;         // Sorted by distance.
+    std::vector<size_t> mBucketStarts;  // Index of the first pair in each distance group. One extra at the end.
+    std::vector<float>  mBucketWeights; // The sum of the pair weights in each distance group.
+    size_t              mLastPair       { 0 };
+    int                 mLastBucket     { 0 };
+    int                 mUnlockedBucket { 0 };
+    
+    [[nodiscard]] float weightOf(const Pair &pair) const;
+    
+    /**
+     * @brief Distances from start to every cell it can reach, in agent steps. -1 if it can't be reached.
+     * @param cells - The cells in the order that they were reached (closest first).
+     */
+    static void search(const Grid &grid, int start, std::vector<int> &distances, std::vector<int> &cells);
+};
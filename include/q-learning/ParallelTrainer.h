@@ -0,0 +1,97 @@
+/**
+ * @file ParallelTrainer.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "QlHelpers.h"
+#include "Environment.h"
+
+class Grid;
+
+/**
+ * Trains a Q-Table with many worker threads at once. Every worker runs its own episodes between random start and
+ * goal cells on the same grid.\n
+ * - Hogwild: every worker reads and writes one shared table with relaxed atomics and no locks. Updates can be
+ * lost when two workers write the same value, which in practice barely matters.\n
+ * - Averaged: every worker trains its own copy of the table. Every K episodes the copies are merged by averaging
+ * each state, weighted by how many times each worker updated it.\n
+ * The trainer takes its own copy of the grid, so edits made to the original while the workers are running are never
+ * seen by them.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class ParallelTrainer
+{
+public:
+    enum class mode : int { Hogwild, Averaged };
+    
+    struct Settings
+    {
+        unsigned int threadCount        { 0 };  // 0 uses the number of hardware threads.
+        mode         trainingMode       { mode::Hogwild };
+        uint64_t     episodes           { 10'000ull };
+        uint64_t     mergeInterval      { 100ull };  // Episodes per worker between merges (Averaged only).
+        uint64_t     iterationMax       { 500ull };
+        float        alpha              { 0.2f };
+        float        gamma              { 0.9f };
+        float        minExplorationRate { 0.001f };
+    };
+    
+    struct Stats
+    {
+        unsigned int threadCount        { 0 };
+        uint64_t     episodes           { 0 };
+        uint64_t     steps              { 0 };
+        double       seconds            { 0.0 };
+        double       episodesPerSecond  { 0.0 };
+        float        successRate        { 0.f };  // Greedy episodes that reached the goal, see evaluate().
+        float        meanSteps          { 0.f };  // Mean length of the successful greedy episodes.
+    };
+
+public:
+    /**
+     * @param environment - The environment to copy into every worker (grid and rewards). The grid is copied here,
+     * so this must be called from the thread that edits it.
+     * @param settings - How to train.
+     */
+    ParallelTrainer(const Environment &environment, const Settings &settings);
+    
+    /**
+     * @brief Trains the table, continuing from the values that are already in it. Blocks until it's finished.
+     * @param qTable - The table to train.
+     * @returns How fast training went and how good the greedy policy is afterwards.
+     */
+    Stats train(QTable &qTable);
+    
+    /**
+     * @brief Runs the greedy policy between a fixed set of start and goal cells (the same every call) so that
+     * tables trained in different ways can be compared.
+     * @param qTable - The table to evaluate.
+     * @param stats - Where successRate and meanSteps are written to.
+     */
+    void evaluate(const QTable &qTable, Stats &stats) const;
+    
+    /**
+     * @brief The same evaluation for a table that wasn't trained by a ParallelTrainer, e.g. single threaded.
+     * @param environment - The grid and rewards that the table was trained on.
+     * @param iterationMax - The most steps each greedy episode can take.
+     */
+    static void evaluate(const QTable &qTable, const Environment &environment, uint64_t iterationMax, Stats &stats);
+
+protected:
+    Environment mEnvironment;
+    Settings    mSettings;
+    
+    void trainHogwild(QTable &qTable, Stats &stats);
+    void trainAveraged(QTable &qTable, Stats &stats);
+};
+
+
@@ -1,5 +1,5 @@
 /**
- * @file QLearning.h
+ * @file QlHelpers.h
  * @author Ryan Purse
  * @date 31/12/2021
  */
@@ -12,21 +12,131 @@
 #endif  // NO_PCH
 
 #include <array>
-#include <map>
 
 enum class action
         : unsigned int {
     North, NorthEast, East, SouthEast, South, SouthWest, West, NorthWest, Count
 };
 
+/**
+ * @brief How far each action moves the agent, in action order (North, NorthEast, East, ... NorthWest).
+ */
+constexpr int actionOffsets[static_cast<size_t>(action::Count)][2] {
+        {  0, -1 }, {  1, -1 }, {  1,  0 }, {  1,  1 }, {  0,  1 }, { -1,  1 }, { -1,  0 }, { -1, -1 }
+};
+
+/**
+ * @param agentAction - The action that you want to look up.
+ * @returns How far the action moves the agent.
+ */
+[[nodiscard]] inline glm::ivec2 getActionOffset(action agentAction)
+{
+    const auto &offset = actionOffsets[static_cast<size_t>(agentAction)];
+    return { offset[0], offset[1] };
+}
+
 /**
  * @brief Defines the direction to the goal.
  */
 enum class direction
-        : char {
-    NoDirection = '0', Left = '1', Up = '1', Right = '2', Down = '2'
+        : unsigned char {
+    NoDirection = 0, Left = 1, Up = 1, Right = 2, Down = 2
 };
 
-typedef std::string                                           State;
+/**
+ * @brief A state packed into an integer: goal * 256 + N * 64 + E * 16 + S * 4 + W, where goal = X * 3 + Y is the
+ * direction to the goal and NESW are the wall distance ranks [0, 4) (one away to four+ away).
+ */
+typedef uint16_t                                              State;
 typedef std::array<float, static_cast<size_t>(action::Count)> ActionValues;
-typedef std::map<State, ActionValues>                         QTable;
+
+constexpr int   wallRankCount   = 4;
+constexpr State stateCount      = 9 * wallRankCount * wallRankCount * wallRankCount * wallRankCount;
+
+/**
+ * @brief The Q-values of every state in one contiguous block. Each state is a 32 byte row, so two states share a
+ * cache line and looking up a state is a single indexed load.
+ */
+struct QTable
+{
+    alignas(64) std::array<ActionValues, stateCount> values {};
+    
+    ActionValues &operator[](State state) { return values[state]; }
+    const ActionValues &operator[](State state) const { return values[state]; }
+};
+
+/**
+ * @brief How much a set of updates changed the Q-values they touched (|deltaQ| per update).
+ */
+struct QChanges
+{
+    float    maxDelta   { 0.f };
+    double   deltaSum   { 0.0 };
+    uint64_t updates    { 0 };
+    
+    void add(float delta)
+    {
+        maxDelta = glm::max(maxDelta, delta);
+        deltaSum += delta;
+        ++updates;
+    }
+    
+    void add(const QChanges &other)
+    {
+        maxDelta = glm::max(maxDelta, other.maxDelta);
+        deltaSum += other.deltaSum;
+        updates  += other.updates;
+    }
+};
+
+/**
+ * @brief Packs the parts of a state into an integer.
+ * @param goalDirection - X * 3 + Y where X and Y are directions to the goal.
+ * @param wallRanks - The wall distance ranks packed as N * 64 + E * 16 + S * 4 + W.
+ * @returns The state.
+ */
+[[nodiscard]] constexpr State encodeState(int goalDirection, int wallRanks)
+{
+    return static_cast<State>(goalDirection * 256 + wallRanks);
+}
+
+/**
+ * @brief Converts a state into the "XYNESW" text used by saved Ai files.
+ * @param state - The state to convert.
+ * @returns The six character key.
+ */
+[[nodiscard]] inline std::string stateToString(State state)
+{
+    const int goalDirection = state / 256;
+    const int wallRanks     = state % 256;
+    std::string key = "XYNESW";
+    key[0] = static_cast<char>('0' + goalDirection / 3);
+    key[1] = static_cast<char>('0' + goalDirection % 3);
+    for (int i = 0; i < 4; ++i)
+        key[2 + i] = static_cast<char>('1' + ((wallRanks >> (6 - 2 * i)) & 3));
+    return key;
+}
+
+/**
+ * @brief Converts "XYNESW" text from a saved Ai file back into a state.
+ * @param key - The six character key.
+ * @param state - Where the state is written to.
+ * @returns False if the key is not a valid state.
+ */
+[[nodiscard]] inline bool stringToState(std::string_view key, State &state)
+{
+    if (key.size() != 6 || key[0] < '0' || key[0] > '2' || key[1] < '0' || key[1] > '2')
+        return false;
+    
+    int wallRanks = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        const char rank = key[2 + i];
+        if (rank < '1' || rank > '4')
+            return false;
+        wallRanks = (wallRanks << 2) | (rank - '1');
+    }
+    
+    state = encodeState((key[0] - '0') * 3 + (key[1] - '0'), wallRanks);
+    return true;
+}
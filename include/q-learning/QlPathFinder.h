@@ -13,6 +13,10 @@
 
 #include "Agent.h"
 #include "Environment.h"
+#include "ParallelTrainer.h"
+#include "BatchEnvironment.h"
+#include "ConvergenceTracker.h"
+#include "PairScheduler.h"
 
 class Grid;
 
@@ -60,6 +64,38 @@ public:
      */
     [[nodiscard]] std::vector<int> trainPath(const glm::ivec2 &start, const glm::ivec2 &end);
     
+    /**
+     * @brief The same as trainPath() but the start and end positions are picked by the curriculum. See
+     * PairScheduler. Only call this if getPairScheduler().isActive().
+     * @returns The path that was taken. The first cell is the start.
+     */
+    [[nodiscard]] std::vector<int> trainScheduledPath();
+    
+    /**
+     * @brief Trains the Ai on many threads at once between random start and end positions, using the same
+     * episodes, iterations, rates and rewards as normal training. Blocks until it's finished.
+     * @param settings - The threads, mode and merge interval to use. The rest is filled in from the Ai.
+     * @returns How fast training went and how good the Ai is afterwards.
+     */
+    ParallelTrainer::Stats trainParallel(ParallelTrainer::Settings settings);
+    
+    /**
+     * @brief Trains the Ai on this thread with updateTrain() until isTrainingFinished(), so traces, replay, Dyna-Q,
+     * early stopping and the curriculum all apply. Without the curriculum, pairs are picked at random like
+     * trainParallel() does. Blocks until it's finished.
+     * @returns Stats that can be compared with trainParallel()'s. The greedy evaluation uses the same pairs.
+     */
+    ParallelTrainer::Stats trainSerial();
+    
+    /**
+     * @brief Trains the Ai by stepping many agents together in a BatchEnvironment between random start and end
+     * positions, using the same episodes, iterations, rates and rewards as normal training. Blocks until it's
+     * finished.
+     * @param agentCount - The number of agents stepped at once.
+     * @returns How fast training went.
+     */
+    BatchEnvironment::Stats trainBatched(int agentCount);
+    
     /**
      * @brief Resets the Ai for a given start and end goal. Used in conjunction with update()
      * @param start - The start position.
@@ -86,10 +122,68 @@ public:
     
     /**
      * @brief Checks to see if training the Ai is finished or not.
-     * @returns True if it the training is finished, false otherwise.
+     * @returns True if the maximum number of episodes has been reached or, with early stopping, the Ai has
+     * converged. See getConvergence() for why.
      */
     [[nodiscard]] bool isTrainingFinished() const;
     
+    /**
+     * @returns True if the current episode reached the goal or ran out of iterations.
+     */
+    [[nodiscard]] bool isEpisodeFinished() const;
+    
+    /**
+     * @brief Sets how many episodes training will run for.
+     * @param episodeMax - The number of episodes.
+     */
+    void setEpisodeMax(uint64_t episodeMax);
+    
+    /**
+     * @brief Sets how many steps an episode can take before it counts as a failure.
+     * @param iterationMax - The maximum number of steps in an episode.
+     */
+    void setIterationMax(uint64_t iterationMax);
+    
+    [[nodiscard]] uint64_t getEpisodeMax() const;
+    [[nodiscard]] uint64_t getIterationMax() const;
+    
+    /**
+     * @brief Sets when normal training is allowed to stop early. Takes effect from the next call to init().
+     */
+    void setConvergenceSettings(const ConvergenceTracker::Settings &settings);
+    
+    /**
+     * @brief Gets how training is converging and, once it has finished, why it stopped.
+     */
+    [[nodiscard]] const ConvergenceTracker &getConvergence() const;
+    
+    /**
+     * @brief Sets how the curriculum picks training pairs. The pairs are searched for again straight away if
+     * there is a grid, otherwise on the next call to init().
+     */
+    void setPairSchedulerSettings(const PairScheduler::Settings &settings);
+    
+    [[nodiscard]] const PairScheduler &getPairScheduler() const;
+    
+    /**
+     * @brief Sets lambda for Q(lambda) in normal training. 0 is one step Q-learning.
+     */
+    void setTraceDecay(float lambda);
+    
+    /**
+     * @brief Sets up experience replay for normal training. See Agent::setReplaySettings().
+     */
+    void setReplaySettings(const ReplayBuffer::Settings &settings);
+    
+    [[nodiscard]] const ReplayBuffer &getReplayBuffer() const;
+    
+    /**
+     * @brief Sets the number of Dyna-Q planning updates per real step in normal training. 0 turns Dyna-Q off.
+     */
+    void setPlanningSteps(int steps);
+    
+    [[nodiscard]] const DynaModel &getModel() const;
+    
     /**
      * @brief Saves the Ai to a given path with the specified name.
      * @param path - A path to a valid folder that exist on disk.
@@ -104,14 +198,21 @@ public:
     void loadAi(std::string_view path);
     
 protected:
-    Agent       mAgent;
-    Environment mEnvironment;
-    uint64_t    mEpisode            { 0 };
-    uint64_t    mEpisodeMax         { 10'000ull };
-    uint64_t    mIteration          { 0 };
-    uint64_t    mIterationMax       { 500ull };
-    bool        mIsEpisodeFinished  { false };
-    std::string mVersion            { "1.01" };
+    Agent              mAgent;
+    Environment        mEnvironment;
+    ConvergenceTracker mConvergence;
+    PairScheduler      mScheduler;
+    uint64_t           mEpisode            { 0 };
+    uint64_t           mEpisodeMax         { 10'000ull };
+    uint64_t           mIteration          { 0 };
+    uint64_t           mIterationMax       { 500ull };
+    bool               mIsEpisodeFinished  { false };
+    std::string        mVersion            { "1.01" };
+    
+    /**
+     * @returns How far through training it is [0, 1]. Used by the curriculum.
+     */
+    [[nodiscard]] float getProgress() const;
 };
 
 
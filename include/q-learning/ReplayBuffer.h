@@ -0,0 +1,122 @@
+/**
+ * @file ReplayBuffer.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "QlHelpers.h"
+
+/**
+ * Experience replay. Every transition the agent makes goes into a fixed size ring buffer (the oldest is overwritten
+ * once it's full) and every few steps a mini-batch is sampled from it and replayed through the Bellman equation.
+ * Samples are either uniform or proportional to how wrong the Q-Table was about them (prioritised). Priorities are
+ * kept in a sum tree so that sampling and updating a priority are both O(log capacity).
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class ReplayBuffer
+{
+public:
+    enum class sampling : unsigned char { Uniform, Prioritised };
+    
+    struct Settings
+    {
+        uint32_t capacity           { 0 };      // Transitions that can be stored. 0 turns replay off.
+        uint32_t batchSize          { 8 };      // Transitions replayed per batch.
+        uint32_t replayInterval     { 8 };      // Steps between batches.
+        sampling samplingMode       { sampling::Uniform };
+        float    priorityExponent   { 0.6f };   // How much priority matters. 0 is uniform.
+        float    importanceExponent { 0.4f };   // How much the bias from prioritised sampling is corrected for.
+    };
+    
+    /**
+     * @brief A single step, packed into 8 bytes. The action is stored in the top bits of the state.
+     */
+    struct Transition
+    {
+        float    reward;
+        uint16_t stateAction;
+        State    nextState;
+    };
+
+public:
+    ReplayBuffer() = default;
+    explicit ReplayBuffer(const Settings &settings);
+    
+    /**
+     * @brief Stores a transition, overwriting the oldest one if the buffer is full. New transitions get the highest
+     * priority seen so far so that they are replayed at least once.
+     */
+    void add(State state, action agentAction, float reward, State nextState);
+    
+    /**
+     * @brief Counts a step and replays a mini-batch if enough steps have passed since the last one.
+     * @returns How much the replayed transitions changed. No updates if nothing was replayed.
+     */
+    QChanges step(QTable &qTable, float alpha, float gamma);
+    
+    /**
+     * @brief Samples a mini-batch and applies the Bellman update for each transition in it.
+     * @param qTable - The table to update.
+     * @param alpha - The learning rate.
+     * @param gamma - The discount factor.
+     * @returns How much the replayed transitions changed.
+     */
+    QChanges replay(QTable &qTable, float alpha, float gamma);
+    
+    /** Removes every transition but keeps the memory. */
+    void clear();
+    
+    [[nodiscard]] bool isEnabled() const;
+    [[nodiscard]] uint32_t getSize() const;
+    [[nodiscard]] const Settings &getSettings() const;
+    
+    /**
+     * @returns The number of bytes used by the transitions, priorities and batch.
+     */
+    [[nodiscard]] size_t getMemoryUsage() const;
+    
+    /**
+     * @param bytes - The most memory that the buffer should use.
+     * @param samplingMode - Prioritised sampling uses more memory per transition.
+     * @returns The largest capacity whose transitions and priorities fit within bytes.
+     */
+    [[nodiscard]] static uint32_t capacityForBytes(size_t bytes, sampling samplingMode);
+    
+    static constexpr int actionShift = 12;  // stateCount fits in 12 bits.
+
+protected:
+    Settings                mSettings;
+    std::vector<Transition> mTransitions;
+    std::vector<float>      mPriorityTree;              // Sum tree: the root is 1 and the leaves start at mLeafCount.
+    std::vector<uint32_t>   mBatch;
+    std::vector<float>      mBatchWeights;
+    uint32_t                mLeafCount          { 0 };
+    uint32_t                mNext               { 0 };
+    uint32_t                mSize               { 0 };
+    uint32_t                mStepsSinceReplay   { 0 };
+    float                   mMaxPriority        { 1.f };  // Already raised to priorityExponent.
+    
+    /** Fills mBatch (and mBatchWeights) with the indices of the transitions to replay. */
+    void sampleBatch();
+    
+    /**
+     * @brief Sets the priority of a transition and updates the sums above it.
+     * @param index - The index of the transition.
+     * @param priority - The priority, already raised to priorityExponent.
+     */
+    void setPriority(uint32_t index, float priority);
+    
+    /**
+     * @param value - [0, total priority).
+     * @returns The index of the transition whose priority range holds value.
+     */
+    [[nodiscard]] uint32_t findPriority(float value) const;
+};
@@ -0,0 +1,309 @@
+/**
+ * @file ChunkedGrid.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "ChunkedGrid.h"
+
+#include "Random.h"
+
+#include <chrono>
+
+namespace
+{
+    // North, NorthEast, East, SouthEast, South, SouthWest, West, NorthWest.
+    constexpr int directions[8][2] { { 0, -1 }, { 1, -1 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 } };
+    
+    ChunkedGrid::chunkType toChunkType(Grid::cellType type)
+    {
+        return type == Grid::cellType::Wall ? ChunkedGrid::chunkType::Wall : ChunkedGrid::chunkType::Empty;
+    }
+}
+
+ChunkedGrid::ChunkedGrid(const glm::ivec2 &size, Grid::cellType fill)
+    : mSize(size), mChunkCount((size + chunkMask) >> chunkShift)
+{
+    const size_t count = static_cast<size_t>(mChunkCount.x) * mChunkCount.y;
+    mTypes.assign(count, toChunkType(fill));
+    mChunks.resize(count);
+}
+
+ChunkedGrid::ChunkedGrid(const Grid &grid)
+    : ChunkedGrid(grid.getSize(), Grid::cellType::Empty)
+{
+    for (int cy = 0; cy < mChunkCount.y; ++cy)
+    {
+        for (int cx = 0; cx < mChunkCount.x; ++cx)
+        {
+            const int index = cx + cy * mChunkCount.x;
+            Chunk &chunk = makeMixed(index);
+            const int rows = rowCount(index);
+            const int columns = std::min(chunkSize, mSize.x - (cx << chunkShift));
+            for (int y = 0; y < rows; ++y)
+            {
+                uint64_t row = 0;
+                for (int x = 0; x < columns; ++x)
+                {
+                    const glm::ivec2 pos { (cx << chunkShift) + x, (cy << chunkShift) + y };
+                    if (grid.getCellType(grid.vectorToIndex(pos)) == Grid::cellType::Wall)
+                        row |= 1ull << x;
+                }
+                chunk.rows[y] = row;
+            }
+            collapse(index);
+        }
+    }
+}
+
+int ChunkedGrid::chunkIndex(const glm::ivec2 &pos) const
+{
+    return (pos.x >> chunkShift) + (pos.y >> chunkShift) * mChunkCount.x;
+}
+
+bool ChunkedGrid::isWall(const glm::ivec2 &pos) const
+{
+    const int index = chunkIndex(pos);
+    switch (mTypes[index])
+    {
+        case chunkType::Empty:
+            return false;
+        case chunkType::Wall:
+            return true;
+        default:
+            return (mChunks[index]->rows[pos.y & chunkMask] >> (pos.x & chunkMask)) & 1u;
+    }
+}
+
+Grid::cellType ChunkedGrid::getCellType(const glm::ivec2 &pos) const
+{
+    return verifyCell(pos) ? Grid::cellType::Empty : Grid::cellType::Wall;
+}
+
+bool ChunkedGrid::verifyCell(const glm::ivec2 &pos) const
+{
+    if (pos.x < 0 || pos.y < 0 || pos.x >= mSize.x || pos.y >= mSize.y)
+        return false;
+    return !isWall(pos);
+}
+
+void ChunkedGrid::setCell(const glm::ivec2 &pos, Grid::cellType type)
+{
+    if (pos.x < 0 || pos.y < 0 || pos.x >= mSize.x || pos.y >= mSize.y)
+        return;
+    
+    const int index = chunkIndex(pos);
+    const bool wall = type == Grid::cellType::Wall;
+    if (mTypes[index] == toChunkType(type) || isWall(pos) == wall)
+        return;  // Nothing has changed.
+    
+    Chunk &chunk = makeMixed(index);
+    chunk.rows[pos.y & chunkMask] ^= 1ull << (pos.x & chunkMask);
+    collapse(index);
+}
+
+void ChunkedGrid::fillRect(const glm::ivec2 &min, const glm::ivec2 &max, Grid::cellType type)
+{
+    const glm::ivec2 low  = glm::max(min, glm::ivec2(0));
+    const glm::ivec2 high = glm::min(max, mSize - 1);
+    if (low.x > high.x || low.y > high.y)
+        return;
+    
+    const bool wall = type == Grid::cellType::Wall;
+    for (int cy = low.y >> chunkShift; cy <= high.y >> chunkShift; ++cy)
+    {
+        for (int cx = low.x >> chunkShift; cx <= high.x >> chunkShift; ++cx)
+        {
+            const int index = cx + cy * mChunkCount.x;
+            const glm::ivec2 chunkMin { cx << chunkShift, cy << chunkShift };
+            const glm::ivec2 chunkMax = glm::min(chunkMin + chunkMask, mSize - 1);
+            if (glm::all(glm::lessThanEqual(low, chunkMin)) && glm::all(glm::greaterThanEqual(high, chunkMax)))
+            {
+                // The whole chunk is covered so it can become a tag.
+                mTypes[index] = toChunkType(type);
+                mChunks[index].reset();
+                continue;
+            }
+            
+            if (mTypes[index] == toChunkType(type))
+                continue;
+            
+            const int x0 = std::max(low.x, chunkMin.x) & chunkMask;
+            const int x1 = std::min(high.x, chunkMax.x) & chunkMask;
+            const uint64_t columns = (x1 == chunkMask ? ~0ull : (1ull << (x1 + 1)) - 1) & ~((1ull << x0) - 1);
+            
+            Chunk &chunk = makeMixed(index);
+            for (int y = std::max(low.y, chunkMin.y); y <= std::min(high.y, chunkMax.y); ++y)
+            {
+                uint64_t &row = chunk.rows[y & chunkMask];
+                row = wall ? row | columns : row & ~columns;
+            }
+            collapse(index);
+        }
+    }
+}
+
+uint8_t ChunkedGrid::getMoveMask(const glm::ivec2 &pos) const
+{
+    const int lx = pos.x & chunkMask;
+    const int ly = pos.y & chunkMask;
+    const bool isInterior = lx > 0 && ly > 0 && lx < chunkMask && ly < chunkMask
+                            && pos.x < mSize.x - 1 && pos.y < mSize.y - 1 && pos.x >= 0 && pos.y >= 0;
+    if (!isInterior)
+    {
+        // On the edge of a chunk (or the world), so the neighbours may live in other chunks.
+        uint8_t mask = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            if (verifyCell(pos + glm::ivec2(directions[i][0], directions[i][1])))
+                mask |= static_cast<uint8_t>(1u << i);
+        }
+        return mask;
+    }
+    
+    const int index = chunkIndex(pos);
+    if (mTypes[index] == chunkType::Empty)
+        return 0xFF;
+    if (mTypes[index] == chunkType::Wall)
+        return 0;
+    
+    // Every neighbour is in this chunk, so only three rows need to be read.
+    const Chunk &chunk = *mChunks[index];
+    const uint64_t above  = ~chunk.rows[ly - 1] >> (lx - 1);
+    const uint64_t middle = ~chunk.rows[ly]     >> (lx - 1);
+    const uint64_t below  = ~chunk.rows[ly + 1] >> (lx - 1);
+    
+    return static_cast<uint8_t>(
+        ((above  >> 1) & 1u)
+        | ((above  >> 2) & 1u) << 1
+        | ((middle >> 2) & 1u) << 2
+        | ((below  >> 2) & 1u) << 3
+        | ((below  >> 1) & 1u) << 4
+        | ((below  >> 0) & 1u) << 5
+        | ((middle >> 0) & 1u) << 6
+        | ((above  >> 0) & 1u) << 7);
+}
+
+const glm::ivec2 &ChunkedGrid::getSize() const
+{
+    return mSize;
+}
+
+ChunkedGrid::chunkType ChunkedGrid::getChunkType(const glm::ivec2 &chunk) const
+{
+    return mTypes[chunk.x + chunk.y * mChunkCount.x];
+}
+
+ChunkedGrid::Stats ChunkedGrid::getStats() const
+{
+    Stats stats {};
+    for (size_t i = 0; i < mTypes.size(); ++i)
+    {
+        ChunkStats &chunkStats = stats[static_cast<size_t>(mTypes[i])];
+        ++chunkStats.count;
+        chunkStats.memoryBytes += sizeof(chunkType) + sizeof(std::shared_ptr<Chunk>);
+        if (mChunks[i])
+            chunkStats.memoryBytes += sizeof(Chunk);
+    }
+    return stats;
+}
+
+ChunkedGrid::Stats ChunkedGrid::measureLookupCost(int samples) const
+{
+    Stats stats = getStats();
+    
+    std::array<std::vector<int>, static_cast<size_t>(chunkType::Count)> chunksOfType;
+    for (size_t i = 0; i < mTypes.size(); ++i)
+        chunksOfType[static_cast<size_t>(mTypes[i])].push_back(static_cast<int>(i));
+    
+    RandomStream rng(0x9E3779B9u);  // Fixed so that every measurement looks up the same cells.
+    
+    for (size_t type = 0; type < chunksOfType.size(); ++type)
+    {
+        const std::vector<int> &chunks = chunksOfType[type];
+        if (chunks.empty())
+            continue;
+        
+        std::vector<glm::ivec2> positions(samples);
+        for (glm::ivec2 &pos : positions)
+        {
+            const int index = chunks[rng.nextBounded(static_cast<uint32_t>(chunks.size()))];
+            const glm::ivec2 chunkMin { (index % mChunkCount.x) << chunkShift, (index / mChunkCount.x) << chunkShift };
+            pos = glm::min(chunkMin + glm::ivec2(rng() & chunkMask, rng() & chunkMask), mSize - 1);
+        }
+        
+        int freeCount = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const glm::ivec2 &pos : positions)
+            freeCount += verifyCell(pos);
+        const auto end = std::chrono::steady_clock::now();
+        
+        volatile int sink = freeCount;  // Stops the loop from being optimised away.
+        (void)sink;
+        
+        const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+        stats[type].lookupNanoseconds = samples > 0 ? nanoseconds / samples : 0.0;
+    }
+    
+    return stats;
+}
+
+uint64_t ChunkedGrid::getMemoryUsage() const
+{
+    uint64_t total = sizeof(ChunkedGrid);
+    for (const ChunkStats &chunkStats : getStats())
+        total += chunkStats.memoryBytes;
+    return total;
+}
+
+ChunkedGrid::Chunk &ChunkedGrid::makeMixed(int index)
+{
+    if (mTypes[index] != chunkType::Mixed)
+    {
+        auto chunk = std::make_shared<Chunk>();
+        if (mTypes[index] == chunkType::Wall)
+            chunk->rows.fill(~0ull);
+        mChunks[index] = std::move(chunk);
+        mTypes[index] = chunkType::Mixed;
+    }
+    else if (mChunks[index].use_count() > 1)
+    {
+        // Another copy of the grid (e.g. a snapshot) still reads this chunk, so write to a clone of it.
+        mChunks[index] = std::make_shared<Chunk>(*mChunks[index]);
+    }
+    return *mChunks[index];
+}
+
+void ChunkedGrid::collapse(int index)
+{
+    if (mTypes[index] != chunkType::Mixed)
+        return;
+    
+    const Chunk &chunk = *mChunks[index];
+    const uint64_t columns = columnMask(index);
+    const int rows = rowCount(index);
+    
+    const uint64_t first = chunk.rows[0] & columns;
+    if (first != 0 && first != columns)
+        return;
+    for (int y = 1; y < rows; ++y)
+    {
+        if ((chunk.rows[y] & columns) != first)
+            return;
+    }
+    
+    mTypes[index] = first == 0 ? chunkType::Empty : chunkType::Wall;
+    mChunks[index].reset();
+}
+
+uint64_t ChunkedGrid::columnMask(int index) const
+{
+    const int columns = std::min(chunkSize, mSize.x - ((index % mChunkCount.x) << chunkShift));
+    return columns == chunkSize ? ~0ull : (1ull << columns) - 1;
+}
+
+int ChunkedGrid::rowCount(int index) const
+{
+    return std::min(chunkSize, mSize.y - ((index / mChunkCount.x) << chunkShift));
+}
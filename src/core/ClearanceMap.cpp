@@ -0,0 +1,213 @@
+/**
+ * @file ClearanceMap.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "ClearanceMap.h"
+
+#include "Grid.h"
+
+#include <cmath>
+
+namespace
+{
+    // Larger than any real distance but small enough that adding a squared distance can't overflow.
+    constexpr int64_t farAway = 1ll << 40;
+    
+    /**
+     * @brief Felzenszwalb and Huttenlocher's 1D squared distance transform on n values spaced apart by stride.
+     * @param values - The values to transform in place.
+     * @param n - The number of values.
+     * @param stride - The distance between each value.
+     * @param f, v, z - Scratch space. Resized as needed.
+     */
+    void euclideanTransform1D(int64_t *values, int n, int stride, std::vector<int64_t> &f,
+                              std::vector<int> &v, std::vector<double> &z)
+    {
+        f.resize(n);
+        v.resize(n);
+        z.resize(n + 1);
+        for (int q = 0; q < n; ++q)
+            f[q] = values[q * stride];
+        
+        const auto intersection = [&f](int q, int p) {
+            return static_cast<double>((f[q] + static_cast<int64_t>(q) * q) - (f[p] + static_cast<int64_t>(p) * p))
+                   / static_cast<double>(2 * q - 2 * p);
+        };
+        
+        // Find the lower envelope of the parabolas rooted at each value.
+        int k = 0;
+        v[0] = 0;
+        z[0] = -std::numeric_limits<double>::infinity();
+        z[1] = std::numeric_limits<double>::infinity();
+        for (int q = 1; q < n; ++q)
+        {
+            double s = intersection(q, v[k]);
+            while (s <= z[k])  // z[0] is -infinity so this always stops.
+            {
+                --k;
+                s = intersection(q, v[k]);
+            }
+            ++k;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = std::numeric_limits<double>::infinity();
+        }
+        
+        // Read the distances back off of the envelope.
+        k = 0;
+        for (int q = 0; q < n; ++q)
+        {
+            while (z[k + 1] < q)
+                ++k;
+            const int64_t diff = q - v[k];
+            values[q * stride] = diff * diff + f[v[k]];
+        }
+    }
+}
+
+ClearanceMap::ClearanceMap(const Grid &grid, ClearanceMap::metric distanceMetric, int maxClearance)
+    : mMetric(distanceMetric), mMaxClearance(glm::clamp(maxClearance, 1, 255))
+{
+    rebuild(grid);
+}
+
+void ClearanceMap::rebuild(const Grid &grid)
+{
+    mSize = grid.getSize();
+    mVersion = grid.getVersion();
+    mClearance.assign(static_cast<size_t>(mSize.x) * mSize.y, 0);
+    compute(grid, glm::ivec2(0), mSize - glm::ivec2(1));
+}
+
+void ClearanceMap::sync(const Grid &grid)
+{
+    if (grid.getVersion() == mVersion)
+        return;
+    
+    std::vector<Grid::Change> changes;
+    if (!grid.changesSince(mVersion, changes))
+    {
+        rebuild(grid);
+        return;
+    }
+    
+    for (const Grid::Change &change : changes)
+        onCellsChanged(grid, change.min, change.max);
+    mVersion = grid.getVersion();
+}
+
+void ClearanceMap::onCellsChanged(const Grid &grid, const glm::ivec2 &min, const glm::ivec2 &max)
+{
+    // Distances are capped, so an edit can only change cells that are within the cap of it.
+    const glm::ivec2 regionMin = glm::max(min - glm::ivec2(mMaxClearance), glm::ivec2(0));
+    const glm::ivec2 regionMax = glm::min(max + glm::ivec2(mMaxClearance), mSize - glm::ivec2(1));
+    if (glm::any(glm::greaterThan(regionMin, regionMax)))
+        return;
+    compute(grid, regionMin, regionMax);
+}
+
+int ClearanceMap::getMaxClearance() const
+{
+    return mMaxClearance;
+}
+
+const std::vector<uint8_t> &ClearanceMap::getClearances() const
+{
+    return mClearance;
+}
+
+void ClearanceMap::compute(const Grid &grid, const glm::ivec2 &min, const glm::ivec2 &max)
+{
+    // Any wall that could be within the cap of the region is inside of the source window. One extra cell past the
+    // edge of the grid is included so that the outside counts as a wall.
+    const glm::ivec2 sourceMin = glm::max(min - glm::ivec2(mMaxClearance), glm::ivec2(-1));
+    const glm::ivec2 sourceMax = glm::min(max + glm::ivec2(mMaxClearance), mSize);
+    const glm::ivec2 size = sourceMax - sourceMin + glm::ivec2(1);
+    
+    std::vector<int64_t> values(static_cast<size_t>(size.x) * size.y);
+    for (int y = 0; y < size.y; ++y)
+    {
+        for (int x = 0; x < size.x; ++x)
+        {
+            const glm::ivec2 pos = sourceMin + glm::ivec2(x, y);
+            values[x + y * size.x] = grid.verifyCell(pos) ? farAway : 0;
+        }
+    }
+    
+    if (mMetric == metric::Chessboard)
+        chessboardTransform(values, size);
+    else
+        euclideanTransform(values, size);
+    
+    for (int y = min.y; y <= max.y; ++y)
+    {
+        for (int x = min.x; x <= max.x; ++x)
+        {
+            const glm::ivec2 local = glm::ivec2(x, y) - sourceMin;
+            const int64_t value = values[local.x + local.y * size.x];
+            const int64_t distance = mMetric == metric::Chessboard
+                    ? value
+                    : static_cast<int64_t>(std::sqrt(static_cast<double>(value)));
+            mClearance[x + y * mSize.x] = static_cast<uint8_t>(glm::min<int64_t>(distance, mMaxClearance));
+        }
+    }
+}
+
+void ClearanceMap::chessboardTransform(std::vector<int64_t> &values, const glm::ivec2 &size)
+{
+    const auto at = [&](int x, int y) -> int64_t& { return values[x + y * size.x]; };
+    
+    // Forward pass looks at the neighbours that have already been visited above and to the left.
+    for (int y = 0; y < size.y; ++y)
+    {
+        for (int x = 0; x < size.x; ++x)
+        {
+            int64_t &value = at(x, y);
+            if (x > 0)
+                value = glm::min(value, at(x - 1, y) + 1);
+            if (y > 0)
+            {
+                value = glm::min(value, at(x, y - 1) + 1);
+                if (x > 0)
+                    value = glm::min(value, at(x - 1, y - 1) + 1);
+                if (x + 1 < size.x)
+                    value = glm::min(value, at(x + 1, y - 1) + 1);
+            }
+        }
+    }
+    
+    // Backward pass does the same with below and to the right.
+    for (int y = size.y - 1; y >= 0; --y)
+    {
+        for (int x = size.x - 1; x >= 0; --x)
+        {
+            int64_t &value = at(x, y);
+            if (x + 1 < size.x)
+                value = glm::min(value, at(x + 1, y) + 1);
+            if (y + 1 < size.y)
+            {
+                value = glm::min(value, at(x, y + 1) + 1);
+                if (x > 0)
+                    value = glm::min(value, at(x - 1, y + 1) + 1);
+                if (x + 1 < size.x)
+                    value = glm::min(value, at(x + 1, y + 1) + 1);
+            }
+        }
+    }
+}
+
+void ClearanceMap::euclideanTransform(std::vector<int64_t> &values, const glm::ivec2 &size)
+{
+    std::vector<int64_t> f;
+    std::vector<int> v;
+    std::vector<double> z;
+    
+    // Separable, so transform every column and then every row.
+    for (int x = 0; x < size.x; ++x)
+        euclideanTransform1D(&values[x], size.y, size.x, f, v, z);
+    for (int y = 0; y < size.y; ++y)
+        euclideanTransform1D(&values[y * size.x], size.x, 1, f, v, z);
+}
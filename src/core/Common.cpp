@@ -7,34 +7,26 @@
 
 #include "Common.h"
 
+#include "Random.h"
+
 #include <chrono>
-#include <random>
 #include <ctime>
 
 
-std::default_random_engine &getGenerator()
-{
-    static std::random_device device;
-    static std::default_random_engine generator(device());
-    return generator;
-}
-
 float randomFloat()
 {
-    static std::uniform_real_distribution<float> distribution(0, 1);
-    return distribution(getGenerator());
+    return getRandomStream().nextFloat();
 }
 
 uint32_t randomInt(uint32_t min, uint32_t max)
 {
-    std::uniform_int_distribution<uint32_t> distribution(min, max);
-    return distribution(getGenerator());
+    return getRandomStream().nextInt(min, max);
 }
 
 std::string getUniqueString()
 {
     const auto now = std::chrono::system_clock::now();
-    const long long time = std::chrono::system_clock::to_time_t(now);
+    const std::time_t time = std::chrono::system_clock::to_time_t(now);
     std::string fileName = std::string(std::ctime(&time));  // ctime() is deprecated but there is no equivalent.
     fileName = fileName.substr(0, fileName.size() - 1);  // Remove the \n
     
@@ -10,6 +10,7 @@
 #include <fstream>
 #include <sstream>
 #include <deque>
+#include <mutex>
 
 namespace debug
 {
@@ -56,6 +57,7 @@ namespace debug
 
     static std::deque<std::string> logQueue;
     static uint64_t logQueueSizeMax { 20ull };
+    static std::mutex logMutex;  // Logs can come from background threads (e.g. maze loading).
 
     // Throw level getters and setters.
     void setThrowLevel(severity level) { throwLevel = level; }
@@ -90,6 +92,7 @@ namespace debug
     {
         std::string output = ss.str();
 
+        std::lock_guard<std::mutex> lock(logMutex);
         logFile(output);
         logConsole(output);
         logToQueue(output);
@@ -146,8 +149,9 @@ namespace debug
         file.close();
     }
     
-    const std::deque<std::string> &getLogs()
+    std::deque<std::string> getLogs()
     {
+        std::lock_guard<std::mutex> lock(logMutex);
         return logQueue;
     }
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+/**
+ * @file FreeCellIndex.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "FreeCellIndex.h"
+
+#include "Common.h"
+
+namespace
+{
+    constexpr int wordShift = 6;  // 64 bits per word.
+    constexpr int wordMask = (1 << wordShift) - 1;
+    constexpr int sampleShift = 6;  // A select sample every 64 empty cells.
+}
+
+FreeCellIndex::FreeCellIndex(int cellCount)
+    : mBits((cellCount + wordMask) >> wordShift, 0ull),
+      mRanks(mBits.size() + 1, 0u),
+      mCellCount(cellCount)
+{
+}
+
+void FreeCellIndex::set(int cell, bool isFree)
+{
+    const int word = cell >> wordShift;
+    const uint64_t bit = 1ull << (cell & wordMask);
+    if (((mBits[word] & bit) != 0) == isFree)
+        return;  // Nothing has changed.
+    
+    mBits[word] ^= bit;
+    for (size_t i = word + 1; i < mRanks.size(); ++i)
+        mRanks[i] += isFree ? 1u : static_cast<uint32_t>(-1);
+    buildSelectSamples();
+}
+
+void FreeCellIndex::set(const std::vector<int> &cells, bool isFree)
+{
+    for (const int cell : cells)
+    {
+        const uint64_t bit = 1ull << (cell & wordMask);
+        mBits[cell >> wordShift] = isFree ? mBits[cell >> wordShift] | bit : mBits[cell >> wordShift] & ~bit;
+    }
+    rebuild();
+}
+
+bool FreeCellIndex::isFree(int cell) const
+{
+    return (mBits[cell >> wordShift] >> (cell & wordMask)) & 1ull;
+}
+
+int FreeCellIndex::count() const
+{
+    return static_cast<int>(mRanks.back());
+}
+
+int FreeCellIndex::rank(int cell) const
+{
+    const int word = cell >> wordShift;
+    const int offset = cell & wordMask;
+    if (offset == 0)
+        return static_cast<int>(mRanks[word]);
+    return static_cast<int>(mRanks[word]) + popCount(mBits[word] & ((1ull << offset) - 1));
+}
+
+int FreeCellIndex::select(int k) const
+{
+    // The samples narrow down which words could hold the k-th cell, then binary search the ranks between them.
+    const size_t sample = static_cast<size_t>(k) >> sampleShift;
+    auto first = mRanks.begin() + mSelectSamples[sample];
+    auto last = sample + 1 < mSelectSamples.size() ? mRanks.begin() + mSelectSamples[sample + 1] + 1 : mRanks.end() - 1;
+    const auto word = std::upper_bound(first, last, static_cast<uint32_t>(k)) - mRanks.begin() - 1;
+    
+    // Drop the lower set bits until the one that we want is the lowest.
+    uint64_t bits = mBits[word];
+    for (uint32_t i = mRanks[word]; i < static_cast<uint32_t>(k); ++i)
+        bits &= bits - 1;
+    return static_cast<int>(word << wordShift) + countTrailingZeros(bits);
+}
+
+int FreeCellIndex::next(int cell) const
+{
+    if (cell >= mCellCount)
+        return -1;
+    
+    const int word = cell >> wordShift;
+    const uint64_t bits = mBits[word] & (~0ull << (cell & wordMask));
+    if (bits != 0)
+        return (word << wordShift) + countTrailingZeros(bits);
+    
+    const int before = static_cast<int>(mRanks[word + 1]);
+    return before < count() ? select(before) : -1;
+}
+
+uint64_t FreeCellIndex::getMemoryUsage() const
+{
+    return mBits.capacity() * sizeof(uint64_t)
+         + mRanks.capacity() * sizeof(uint32_t)
+         + mSelectSamples.capacity() * sizeof(uint32_t);
+}
+
+void FreeCellIndex::rebuild()
+{
+    for (size_t word = 0; word < mBits.size(); ++word)
+        mRanks[word + 1] = mRanks[word] + popCount(mBits[word]);
+    buildSelectSamples();
+}
+
+void FreeCellIndex::buildSelectSamples()
+{
+    mSelectSamples.clear();
+    uint32_t nextSample = 0;
+    for (uint32_t word = 0; word < mBits.size(); ++word)
+    {
+        // Every sample that falls inside of this word points at it.
+        while (nextSample < mRanks[word + 1])
+        {
+            mSelectSamples.push_back(word);
+            nextSample += 1u << sampleShift;
+        }
+    }
+}
@@ -7,60 +7,118 @@
 
 #include "Grid.h"
 
-#include <utility>
+#include "Common.h"
 
-Grid::Grid(Grid::Cells cells, const int width)
-    : mCells(std::move(cells)), mWidth(width)
+namespace
 {
+    constexpr uint8_t paddedEmpty = static_cast<uint8_t>(Grid::cellType::Empty);
+    constexpr uint8_t paddedWall  = static_cast<uint8_t>(Grid::cellType::Wall);
+    
+    /**
+     * @returns One further from the wall than distance, without going past Grid::maxWallDistance.
+     */
+    uint8_t nextWallDistance(uint8_t distance)
+    {
+        return static_cast<uint8_t>(glm::min(static_cast<int>(distance) + 1, Grid::maxWallDistance));
+    }
+    
+    // North, NorthEast, East, SouthEast, South, SouthWest, West, NorthWest.
+    constexpr int directions[8][2] { { 0, -1 }, { 1, -1 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 } };
+}
 
+Grid::Grid(const Grid::Cells &cells, const int width)
+    : mWidth(width), mHeight(static_cast<int>(cells.size()) / width), mCellCount(static_cast<int>(cells.size()))
+{
+    initCells(cells);
+    
+    mMoveMasks.resize(mCellCount);
+    for (Cell cell = 0; cell < mCellCount; ++cell)
+        buildMoveMask(cell);
+    
+    mWallDistances.resize(mCellCount);
+    for (int x = 0; x < mWidth; ++x)
+        buildColumnWallDistances(x);
+    for (int y = 0; y < mHeight; ++y)
+        buildRowWallDistances(y);
+}
+
+Grid::Grid(const Grid::Cells &cells, int width, const Grid::Tables &tables)
+    : mWidth(width), mHeight(static_cast<int>(cells.size()) / width), mCellCount(static_cast<int>(cells.size()))
+{
+    initCells(cells);
+    mMoveMasks.assign(tables.moveMasks, tables.moveMasks + mCellCount);
+    mWallDistances.assign(tables.wallDistances, tables.wallDistances + mCellCount);
+}
+
+void Grid::initCells(const Grid::Cells &cells)
+{
+    const int paddedWidth = mWidth + 2;
+    mPadded.assign(static_cast<size_t>(paddedWidth) * (mHeight + 2), paddedWall);
+    for (int i = 0; i < 8; ++i)
+    {
+        mPaddedOffsets[i] = directions[i][0] + directions[i][1] * paddedWidth;
+        mCellOffsets[i]   = directions[i][0] + directions[i][1] * mWidth;
+    }
+    
+    for (Cell cell = 0; cell < mCellCount; ++cell)
+        mPadded[paddedIndex(cell)] = static_cast<uint8_t>(cells[cell]);
+    
+    constexpr int empty = static_cast<int>(cellType::Empty);
+    mFreeCells = FreeCellIndex(mCellCount, [&cells](Cell cell) { return cells[cell] == empty; });
 }
 
 glm::ivec2 Grid::indexToVector(Cell index) const
 {
-    if (0 > index || index >= mCells.size())
+    if (0 > index || index >= mCellCount)
         return { -1, -1 };  // Not a valid cell, out of range.
     return { index % mWidth, static_cast<int>((index / mWidth)) };
 }
 
 Grid::Cell Grid::vectorToIndex(glm::ivec2 vector) const
 {
-    if (vector.x < 0 || vector.y < 0 || vector.x >= mWidth || vector.x * vector.y >= mCells.size())
+    if (vector.x < 0 || vector.y < 0 || vector.x >= mWidth || vector.y >= mHeight)
         return -1;  // Not a valid space, out of range.
     return vector.x + vector.y * mWidth;
 }
 
 Grid::Cells Grid::getAdjacent(Grid::Cell cell) const
 {
-    Cells queriedCells { cell - mWidth, cell + mWidth };
-    
-    if ((cell % mWidth) != 0)  // Cell not along the left wall.
-        queriedCells.emplace_back(cell - 1);
+    Cells selected;
+    if (cell < 0 || cell >= mCellCount)
+        return selected;
     
-    if ((cell + 1) % mWidth != 0)  // Cell not along the right wall.
-        queriedCells.emplace_back(cell + 1);
+    // Every other direction is orthogonal.
+    uint32_t moves = mMoveMasks[cell] & 0b01010101u;
+    while (moves != 0)
+    {
+        selected.emplace_back(cell + mCellOffsets[countTrailingZeros(moves)]);
+        moves &= moves - 1;  // Clear the lowest bit.
+    }
     
-    return validateAllCells(queriedCells);
+    return selected;
 }
 
 Grid::Cells Grid::getSurrounding(Grid::Cell cell) const
 {
-    Cells queriedCells { cell - mWidth, cell + mWidth };
-    
-    if ((cell % mWidth) != 0)  // Cell not along the left wall.
-    {
-        queriedCells.emplace_back(cell - 1);
-        queriedCells.emplace_back(cell - 1 - mWidth);
-        queriedCells.emplace_back(cell - 1 + mWidth);
-    }
+    std::array<Cell, 8> surrounding {};
+    const int count = getSurrounding(cell, surrounding);
+    return Cells(surrounding.begin(), surrounding.begin() + count);
+}
+
+int Grid::getSurrounding(Grid::Cell cell, std::array<Cell, 8> &out) const
+{
+    if (cell < 0 || cell >= mCellCount)
+        return 0;
     
-    if ((cell + 1) % mWidth != 0)  // Cell not along the right wall.
+    int count = 0;
+    uint32_t moves = mMoveMasks[cell];
+    while (moves != 0)
     {
-        queriedCells.emplace_back(cell + 1);
-        queriedCells.emplace_back(cell + 1 - mWidth);
-        queriedCells.emplace_back(cell + 1 + mWidth);
+        out[count++] = cell + mCellOffsets[countTrailingZeros(moves)];
+        moves &= moves - 1;  // Clear the lowest bit.
     }
     
-    return validateAllCells(queriedCells);
+    return count;
 }
 
 float Grid::getDistance(Grid::Cell a, Grid::Cell b) const
@@ -81,79 +139,239 @@ Grid::Cell Grid::getOrthogonalDistance(const glm::ivec2 &a, const glm::ivec2 &b)
     return diffVec.x + diffVec.y;
 }
 
-Grid::Cells Grid::getDistanceToOrthogonalWalls(Grid::Cell cell) const
+Grid::Cell Grid::getDiagonalDistance(Grid::Cell a, Grid::Cell b) const
+{
+    const auto diffVec = glm::abs(indexToVector(a) - indexToVector(b));
+    return glm::max(diffVec.x, diffVec.y);
+}
+
+const Grid::WallDistances &Grid::getDistanceToOrthogonalWalls(Grid::Cell cell) const
+{
+    return mWallDistances[cell];
+}
+
+bool Grid::verifyCell(Grid::Cell cell) const
+{
+    // The free cell bits are exactly the empty cells, and reading them doesn't need the divide that paddedIndex() does.
+    if (cell < 0 || cell >= mCellCount)
+        return false;
+    return mFreeCells.isFree(cell);
+}
+
+bool Grid::verifyCell(const glm::ivec2 &pos) const
+{
+    if (pos.x < 0 || pos.y < 0 || pos.x >= mWidth || pos.y >= mHeight)
+        return false;
+    return mPadded[(pos.x + 1) + (pos.y + 1) * (mWidth + 2)] == paddedEmpty;
+}
+
+Grid::Cell Grid::moveToNextValidCell(Grid::Cell cell) const
+{
+    Cell next = mFreeCells.next(cell + 1);
+    if (next < 0)
+        next = mFreeCells.next(0);  // Loop back to the top.
+    return next < 0 ? cell : next;
+}
+
+void Grid::setCell(Grid::Cell cell, Grid::cellType type)
+{
+    const glm::ivec2 pos = indexToVector(cell);
+    writeCell(cell, type);
+    mFreeCells.set(cell, type == cellType::Empty);  // verifyCell() reads this.
+    
+    // Only cells in the same row and column can see this cell.
+    buildColumnWallDistances(pos.x);
+    buildRowWallDistances(pos.y);
+    
+    ++mVersion;
+    record(pos, pos);
+}
+
+void Grid::setCells(const Grid::Cells &cells, Grid::cellType type)
+{
+    if (cells.empty())
+        return;
+    
+    std::vector<bool> dirtyColumns(mWidth, false);
+    std::vector<bool> dirtyRows(mHeight, false);
+    for (const Cell cell : cells)
+    {
+        writeCell(cell, type);
+        const glm::ivec2 pos = indexToVector(cell);
+        dirtyColumns[pos.x] = true;
+        dirtyRows[pos.y] = true;
+    }
+    
+    mFreeCells.set(cells, type == cellType::Empty);  // Counts once for the whole batch.
+    
+    for (int x = 0; x < mWidth; ++x)
+    {
+        if (dirtyColumns[x])
+            buildColumnWallDistances(x);
+    }
+    for (int y = 0; y < mHeight; ++y)
+    {
+        if (dirtyRows[y])
+            buildRowWallDistances(y);
+    }
+    
+    ++mVersion;
+    for (const Cell cell : cells)
+    {
+        const glm::ivec2 pos = indexToVector(cell);
+        record(pos, pos);
+    }
+}
+
+void Grid::fillRect(const glm::ivec2 &min, const glm::ivec2 &max, Grid::cellType type)
 {
-    Cells out;
-    const std::vector<glm::ivec2> directions { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
-    const glm::ivec2 startPos = indexToVector(cell);
+    const glm::ivec2 low  = glm::max(min, glm::ivec2(0));
+    const glm::ivec2 high = glm::min(max, getSize() - 1);
+    if (low.x > high.x || low.y > high.y)
+        return;
     
-    for (const auto &direction : directions)
+    for (int y = low.y; y <= high.y; ++y)
     {
-        bool hitWall = false;
-        auto currentCellPos = startPos;
-        
-        while (!hitWall)
-        {
-            currentCellPos += direction;
-            hitWall = !verifyCell(currentCellPos);
-        }
-        
-        const glm::ivec2 diff = currentCellPos - startPos;
-        out.push_back(glm::abs(diff.x) + glm::abs(diff.y));
+        for (int x = low.x; x <= high.x; ++x)
+            writeCell(x + y * mWidth, type);
     }
     
-    return out;
+    // One O(n) rebuild is cheaper than patching the rank of every cell in the area.
+    mFreeCells = FreeCellIndex(mCellCount, [this](Cell cell) { return getCellType(cell) == cellType::Empty; });
+    
+    for (int x = low.x; x <= high.x; ++x)
+        buildColumnWallDistances(x);
+    for (int y = low.y; y <= high.y; ++y)
+        buildRowWallDistances(y);
+    
+    ++mVersion;
+    record(low, high);
 }
 
-bool Grid::verifyCell(Grid::Cell cell) const
+uint64_t Grid::getVersion() const
 {
-    const auto pos = indexToVector(cell);
-    return isInBounds(cell, pos);
+    return mVersion;
 }
 
-bool Grid::verifyCell(const glm::ivec2 &pos) const
+bool Grid::changesSince(uint64_t version, std::vector<Change> &out) const
 {
-    const Cell cell = vectorToIndex(pos);
-    return isInBounds(cell, pos);
+    out.clear();
+    if (version < mJournalStart)
+        return false;  // Some of the changes have been dropped.
+    
+    // The journal is in version order, so only the tail needs to be copied.
+    auto first = std::upper_bound(mJournal.begin(), mJournal.end(), version, [](uint64_t v, const Change &change) {
+        return v < change.version;
+    });
+    out.assign(first, mJournal.end());
+    return true;
 }
 
-Grid::Cell Grid::moveToNextValidCell(Grid::Cell cell) const
+glm::ivec2 Grid::getSize() const
+{
+    return { mWidth, mHeight };
+}
+
+int Grid::getCellCount() const
 {
-    do
+    return mCellCount;
+}
+
+const FreeCellIndex &Grid::getFreeCells() const
+{
+    return mFreeCells;
+}
+
+Grid::cellType Grid::getCellType(Grid::Cell cell) const
+{
+    return static_cast<cellType>(mPadded[paddedIndex(cell)]);
+}
+
+Grid::Tables Grid::getTables() const
+{
+    return { mWallDistances.data(), mMoveMasks.data() };
+}
+
+uint64_t Grid::getMemoryUsage() const
+{
+    return mPadded.capacity() * sizeof(uint8_t)
+         + mMoveMasks.capacity() * sizeof(uint8_t)
+         + mFreeCells.getMemoryUsage()
+         + mWallDistances.capacity() * sizeof(WallDistances)
+         + mJournal.size() * sizeof(Change);
+}
+
+void Grid::buildMoveMask(Grid::Cell cell)
+{
+    const int padded = paddedIndex(cell);
+    uint8_t mask = 0;
+    for (int i = 0; i < 8; ++i)
     {
-        cell++;
-        if (cell >= mCells.size())
-            cell = 0;
+        if (mPadded[padded + mPaddedOffsets[i]] == paddedEmpty)
+            mask |= static_cast<uint8_t>(1u << i);
     }
-    while (!verifyCell(cell));
-    return cell;
+    mMoveMasks[cell] = mask;
 }
 
-const Grid::Cells &Grid::getCells() const
+void Grid::writeCell(Grid::Cell cell, Grid::cellType type)
 {
-    return mCells;
+    const glm::ivec2 pos = indexToVector(cell);
+    mPadded[paddedIndex(cell)] = static_cast<uint8_t>(type);
+    
+    // Only the moves into this cell have changed.
+    for (int i = 0; i < 8; ++i)
+    {
+        const glm::ivec2 neighbour = pos + glm::ivec2(directions[i][0], directions[i][1]);
+        if (neighbour.x >= 0 && neighbour.y >= 0 && neighbour.x < mWidth && neighbour.y < mHeight)
+            buildMoveMask(cell + mCellOffsets[i]);
+    }
 }
 
-Grid::Cells Grid::validateAllCells(const Grid::Cells &cells) const
+void Grid::record(const glm::ivec2 &min, const glm::ivec2 &max)
 {
-    Cells selected;
-    for (const Cell &qCell : cells)
+    mJournal.push_back({ mVersion, min, max });
+    while (mJournal.size() > journalCapacity)
+    {
+        // Anyone synced to before this version would miss it.
+        mJournalStart = mJournal.front().version;
+        mJournal.pop_front();
+    }
+}
+
+void Grid::buildColumnWallDistances(int x)
+{
+    // A cell is one away from a wall if the cell next to it is a wall, otherwise it's one further than that cell.
+    // The border is made of walls, so the edges of the grid need no special case.
+    const int paddedWidth = mWidth + 2;
+    for (int y = 0; y < mHeight; ++y)
     {
-        if (verifyCell(qCell))
-            selected.emplace_back(qCell);  // Cell is in rage, therefore add it.
+        const Cell cell = x + y * mWidth;
+        const bool isOpen = mPadded[(x + 1) + y * paddedWidth] != paddedWall;
+        mWallDistances[cell][0] = isOpen ? nextWallDistance(mWallDistances[cell - mWidth][0]) : 1;
     }
     
-    return selected;
+    for (int y = mHeight - 1; y >= 0; --y)
+    {
+        const Cell cell = x + y * mWidth;
+        const bool isOpen = mPadded[(x + 1) + (y + 2) * paddedWidth] != paddedWall;
+        mWallDistances[cell][2] = isOpen ? nextWallDistance(mWallDistances[cell + mWidth][2]) : 1;
+    }
 }
 
-bool Grid::isInBounds(Grid::Cell cell, const glm::ivec2 &pos) const
+void Grid::buildRowWallDistances(int y)
 {
-    if (cell < 0 || cell >= mCells.size())
-        return false;
-    if (pos.x < 0 || pos.x >= mWidth)
-        return false;
-    if (mCells[cell] == static_cast<Cell>(Grid::cellType::Wall))
-        return false;
+    const uint8_t *row = &mPadded[(y + 1) * (mWidth + 2) + 1];  // row[x] is the cell at x.
+    for (int x = 0; x < mWidth; ++x)
+    {
+        const Cell cell = x + y * mWidth;
+        const bool isOpen = row[x - 1] != paddedWall;
+        mWallDistances[cell][3] = isOpen ? nextWallDistance(mWallDistances[cell - 1][3]) : 1;
+    }
     
-    return true;
+    for (int x = mWidth - 1; x >= 0; --x)
+    {
+        const Cell cell = x + y * mWidth;
+        const bool isOpen = row[x + 1] != paddedWall;
+        mWallDistances[cell][1] = isOpen ? nextWallDistance(mWallDistances[cell + 1][1]) : 1;
+    }
 }
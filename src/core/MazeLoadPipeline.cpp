@@ -0,0 +1,185 @@
+/**
+ * @file MazeLoadPipeline.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "MazeLoadPipeline.h"
+
+#include "MazeLoader.h"
+#include "GridCache.h"
+
+MazeLoadPipeline::~MazeLoadPipeline()
+{
+    cancel();
+    if (mLoad != nullptr)
+        mCancelledLoads.push_back(std::move(mLoad));
+    
+    for (auto &load : mCancelledLoads)
+        load->thread.join();
+}
+
+void MazeLoadPipeline::start(std::string_view filePath)
+{
+    // The old load may be in the middle of building a big grid, so it's left to finish on its own.
+    cancel();
+    if (mLoad != nullptr)
+        mCancelledLoads.push_back(std::move(mLoad));
+    joinCancelled();
+    
+    mLoad = std::make_unique<Load>();
+    mLoad->thread = std::thread(&MazeLoadPipeline::run, std::ref(*mLoad), std::string(filePath));
+}
+
+void MazeLoadPipeline::cancel()
+{
+    if (mLoad != nullptr)
+        mLoad->isCancelled.store(true, std::memory_order_relaxed);
+}
+
+std::unique_ptr<MazeLoadPipeline::Result> MazeLoadPipeline::poll()
+{
+    joinCancelled();
+    if (mLoad == nullptr || isRunning(*mLoad))
+        return nullptr;
+    
+    mLoad->thread.join();
+    const std::unique_ptr<Load> load = std::move(mLoad);
+    
+    // A load that was cancelled after its last stage still shouldn't be swapped in.
+    const bool isCancelled = load->isCancelled.load(std::memory_order_relaxed);
+    switch (isCancelled ? stage::Cancelled : load->loadStage.load(std::memory_order_acquire))
+    {
+        case stage::Finished:
+            return std::move(load->result);
+        case stage::Failed:
+            debug::log("The format of the maze does not work. Make sure you are using UTF-8", debug::severity::Minor);
+            break;
+        case stage::Cancelled:
+            debug::log("Loading the maze was cancelled.");
+            break;
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+bool MazeLoadPipeline::isRunning() const
+{
+    return mLoad != nullptr && isRunning(*mLoad);
+}
+
+MazeLoadPipeline::stage MazeLoadPipeline::getStage() const
+{
+    return mLoad != nullptr ? mLoad->loadStage.load(std::memory_order_acquire) : stage::Idle;
+}
+
+float MazeLoadPipeline::getProgress() const
+{
+    switch (getStage())
+    {
+        case stage::Parsing:
+            return 0.f;
+        case stage::BuildingGrid:
+            return 1.f / 3.f;
+        case stage::BuildingMesh:
+            return 2.f / 3.f;
+        case stage::Finished:
+            return 1.f;
+        default:
+            return 0.f;
+    }
+}
+
+std::string_view MazeLoadPipeline::toString(MazeLoadPipeline::stage loadStage)
+{
+    switch (loadStage)
+    {
+        case stage::Idle:
+            return "Idle";
+        case stage::Parsing:
+            return "Parsing";
+        case stage::BuildingGrid:
+            return "Building Grid";
+        case stage::BuildingMesh:
+            return "Building Mesh";
+        case stage::Finished:
+            return "Finished";
+        case stage::Failed:
+            return "Failed";
+        case stage::Cancelled:
+            return "Cancelled";
+        default:
+            return "Unknown";
+    }
+}
+
+void MazeLoadPipeline::run(MazeLoadPipeline::Load &load, std::string filePath)
+{
+    auto result = std::make_unique<Result>();
+    
+    const auto data = fileSystem::loadMaze(filePath);
+    if (data.grid.empty())
+    {
+        load.loadStage.store(stage::Failed, std::memory_order_release);
+        return;
+    }
+    
+    // The grid builds its wall distances, move masks and free cell index as part of construction, unless they
+    // can be taken from the cache next to the maze.
+    if (!advance(load, stage::BuildingGrid))
+        return;
+    result->grid = fileSystem::loadGridCache(filePath, data);
+    result->isFromCache = result->grid != nullptr;
+    if (!result->isFromCache)
+    {
+        result->grid = std::make_shared<Grid>(data.grid, data.gridSize.x);
+        
+        // A load that replaced this one may be writing the same cache.
+        if (!advance(load, stage::BuildingGrid))
+            return;
+        fileSystem::saveGridCache(filePath, data, *result->grid);
+    }
+    result->startPos = result->grid->indexToVector(data.startIndex);
+    result->endPos   = result->grid->indexToVector(data.endIndex);
+    
+    // The mesh is only vertex data until it is drawn, so it's safe to build off of the render thread.
+    if (!advance(load, stage::BuildingMesh))
+        return;
+    result->mesh = std::make_unique<GridMesh>(data.gridSize);
+    
+    if (!advance(load, stage::Finished))
+        return;
+    load.result = std::move(result);
+    load.loadStage.store(stage::Finished, std::memory_order_release);
+}
+
+bool MazeLoadPipeline::advance(MazeLoadPipeline::Load &load, MazeLoadPipeline::stage nextStage)
+{
+    if (load.isCancelled.load(std::memory_order_relaxed))
+    {
+        load.loadStage.store(stage::Cancelled, std::memory_order_release);
+        return false;
+    }
+    
+    if (nextStage != stage::Finished)  // Finished is only published once the result has been written.
+        load.loadStage.store(nextStage, std::memory_order_release);
+    return true;
+}
+
+bool MazeLoadPipeline::isRunning(const MazeLoadPipeline::Load &load)
+{
+    const stage current = load.loadStage.load(std::memory_order_acquire);
+    return current == stage::Parsing || current == stage::BuildingGrid || current == stage::BuildingMesh;
+}
+
+void MazeLoadPipeline::joinCancelled()
+{
+    // Each worker's last act is to publish its stage, so a load that isn't running has returned or is about to.
+    auto firstRunning = std::partition(mCancelledLoads.begin(), mCancelledLoads.end(),
+                                       [](const std::unique_ptr<Load> &load) { return isRunning(*load); });
+    for (auto it = firstRunning; it != mCancelledLoads.end(); ++it)
+        (*it)->thread.join();
+    mCancelledLoads.erase(firstRunning, mCancelledLoads.end());
+}
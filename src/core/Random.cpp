@@ -0,0 +1,90 @@
+/**
+ * @file Random.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "Random.h"
+
+#include <atomic>
+#include <random>
+#include <tuple>
+
+namespace
+{
+    uint64_t splitMix64(uint64_t &state)
+    {
+        state += 0x9E3779B97F4A7C15ull;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    
+    std::atomic<uint64_t> &masterSeed()
+    {
+        static std::atomic<uint64_t> seed { (static_cast<uint64_t>(std::random_device{}()) << 32)
+                                            | std::random_device{}() };
+        return seed;
+    }
+    
+    std::atomic<uint64_t> &nextStream()
+    {
+        static std::atomic<uint64_t> stream { 1ull };  // 0 is kept for the thread that calls setRandomSeed().
+        return stream;
+    }
+}
+
+RandomStream::RandomStream(uint64_t seed, uint64_t stream)
+{
+    uint64_t splitMixState = seed;
+    for (size_t i = 0; i < mState.size(); i += 2)
+    {
+        const uint64_t value = splitMix64(splitMixState);
+        mState[i]     = static_cast<uint32_t>(value);
+        mState[i + 1] = static_cast<uint32_t>(value >> 32);
+    }
+    
+    // Only the streams that are actually used are made, so a few thousand jumps at most.
+    for (uint64_t i = 0; i < stream; ++i)
+        jump();
+}
+
+void RandomStream::jump()
+{
+    constexpr std::array<uint32_t, 4> jumpPolynomial { 0x8764000bu, 0xf542d2d3u, 0x6fa035c3u, 0x77f2db5bu };
+    
+    std::array<uint32_t, 4> jumped {};
+    for (const uint32_t word : jumpPolynomial)
+    {
+        for (int bit = 0; bit < 32; ++bit)
+        {
+            if (word & (1u << bit))
+            {
+                for (size_t i = 0; i < jumped.size(); ++i)
+                    jumped[i] ^= mState[i];
+            }
+            std::ignore = (*this)();
+        }
+    }
+    mState = jumped;
+}
+
+void setRandomSeed(uint64_t seed)
+{
+    masterSeed() = seed;
+    nextStream() = 1ull;
+    getRandomStream() = RandomStream(seed, 0ull);
+}
+
+uint64_t getRandomSeed()
+{
+    return masterSeed();
+}
+
+RandomStream &getRandomStream()
+{
+    thread_local RandomStream stream(masterSeed(), nextStream()++);
+    return stream;
+}
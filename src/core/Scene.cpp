@@ -8,25 +8,49 @@
 #include "Scene.h"
 
 #include "Pathfinding.h"
-#include "MazeLoader.h"
+#include "SearchContext.h"
 #include "Common.h"
 #include "FileIoCommon.h"
 
 #include <imgui_impl_glfw.h>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    std::string describe(const ParallelTrainer::Stats &stats)
+    {
+        std::stringstream ss;
+        ss << stats.threadCount << " thread(s): " << static_cast<uint64_t>(stats.episodesPerSecond) << " episodes/s, "
+           << stats.successRate * 100.f << "% reached the goal in " << stats.meanSteps << " steps on average.";
+        return ss.str();
+    }
+}
 
 Scene::Scene(const glm::ivec2 &resolution)
     : mRendererSystem(resolution)
 {
     mMazeExplorer.onSelect([this](std::string_view filePath) {
-        loadGrid(filePath);
+        mMazeLoader.start(filePath);
     });
     mAiExplorer.onSelect([this](std::string_view filePath) {
         mPathFinder.loadAi(filePath);
     });
 }
 
+Scene::~Scene()
+{
+    // Training can't be cancelled part way through, so this waits for it.
+    if (mBackgroundTraining != nullptr)
+        mBackgroundTraining->thread.join();
+}
+
 void Scene::update()
 {
+    if (auto result = mMazeLoader.poll())
+        swapGrid(std::move(*result));
+    pollBackgroundTraining();
+    
     if (!mIsValidMaze)
         return;
     
@@ -65,22 +89,16 @@ void Scene::renderImGui()
     showSidePanel();
 }
 
-void Scene::loadGrid(std::string_view filePath)
+void Scene::swapGrid(MazeLoadPipeline::Result &&result)
 {
-    mIsValidMaze = false;
-    auto data = fileSystem::loadMaze(filePath);
+    if (result.isFromCache)
+        debug::log("Loaded the maze's tables from its cache.");
     
-    if (data.grid.empty())
-    {
-        debug::log("The format of the maze does not work. Make sure you are using UTF-8", debug::severity::Minor);
-        return;
-    }
-    
-    mGrid     = std::make_shared<Grid>(data.grid, data.gridSize.x);
-    mStartPos = mGrid->indexToVector(data.startIndex);
-    mEndPos   = mGrid->indexToVector(data.endIndex);
-    mGridMesh = std::make_unique<GridMesh>(data.gridSize);
-    mMaxPos   = data.gridSize - glm::ivec2(1);
+    mGrid     = std::move(result.grid);
+    mGridMesh = std::move(result.mesh);
+    mStartPos = result.startPos;
+    mEndPos   = result.endPos;
+    mMaxPos   = mGrid->getSize() - glm::ivec2(1);
     
     mPathFinder.init(mGrid);
     mPathFinder.resetTraining(mStartPos, mEndPos);
@@ -107,7 +125,8 @@ void Scene::updateTrainAi()
     if (!mRunTraining)
         return;
     
-    const auto path = mPathFinder.trainPath(mStartPos, mEndPos);
+    const auto path = mPathFinder.getPairScheduler().isActive() ? mPathFinder.trainScheduledPath()
+                                                                 : mPathFinder.trainPath(mStartPos, mEndPos);
     
     for (const auto &node : path)
         mGridMesh->setCellColour(mGrid->indexToVector(node), mColours.path);
@@ -118,14 +137,66 @@ void Scene::updateTrainAi()
     mEndPos = mGrid->indexToVector(mEndCell);
     
     if (mPathFinder.isTrainingFinished())
+        finishTraining();
+}
+
+void Scene::trainAiInParallel()
+{
+    startBackgroundTraining([settings = mParallelSettings, isComparing = mCompareParallel](QlPathFinder &pathFinder) {
+        // The baseline is the ordinary single threaded trainer, evaluated on the same pairs.
+        if (isComparing)
+        {
+            auto baseline = std::make_unique<QlPathFinder>(pathFinder);
+            debug::log("Single thread baseline. " + describe(baseline->trainSerial()));
+        }
+        
+        debug::log("Parallel training. " + describe(pathFinder.trainParallel(settings)));
+    });
+}
+
+void Scene::startBackgroundTraining(std::function<void(QlPathFinder&)> job)
+{
+    mPathFinder.init(mGrid);
+    mRunTraining = false;
+    
+    mBackgroundTraining = std::make_unique<BackgroundTraining>();
+    mBackgroundTraining->grid = mGrid;
+    mBackgroundTraining->pathFinder = std::make_unique<QlPathFinder>(mPathFinder);
+    mBackgroundTraining->thread = std::thread([training = mBackgroundTraining.get(), job = std::move(job)]() {
+        job(*training->pathFinder);
+        training->isFinished.store(true, std::memory_order_release);
+    });
+}
+
+void Scene::pollBackgroundTraining()
+{
+    if (mBackgroundTraining == nullptr || !mBackgroundTraining->isFinished.load(std::memory_order_acquire))
+        return;
+    
+    mBackgroundTraining->thread.join();
+    const std::unique_ptr<BackgroundTraining> training = std::move(mBackgroundTraining);
+    if (training->grid != mGrid)
     {
-        mRunTraining = false;
-        mOption = RunAi;
-        const auto saveName = getUniqueString() + ".txt";
-        mPathFinder.saveAi("../res/ai/", saveName);
-        mAiExplorer.update();
-        debug::log("Finished Training AI. Your AI was save to: " + saveName);
+        debug::log("The maze changed while the AI was training, so it was thrown away.", debug::severity::Minor);
+        return;
     }
+    
+    mPathFinder = std::move(*training->pathFinder);
+    finishTraining();
+}
+
+void Scene::finishTraining()
+{
+    mRunTraining = false;
+    mOption = RunAi;
+    const auto saveName = getUniqueString() + ".txt";
+    mPathFinder.saveAi("../res/ai/", saveName);
+    mAiExplorer.update();
+    debug::log("Finished Training AI. Your AI was save to: " + saveName);
+    
+    const ConvergenceTracker::Stats &stats = mPathFinder.getConvergence().getStats();
+    debug::log("Training stopped after " + std::to_string(stats.episodes) + " episodes: "
+               + std::string(ConvergenceTracker::toString(stats.reason)));
 }
 
 void Scene::updateRunAi()
@@ -136,7 +207,7 @@ void Scene::updateRunAi()
         const auto pos = mGrid->indexToVector(node);
         mGridMesh->setCellColour(pos, mColours.path);
     }
-    
+
 }
 
 void Scene::updateTestAi()
@@ -149,10 +220,9 @@ void Scene::updateTestAi()
     mStartPos = mGrid->indexToVector(mStartCell);
     mEndPos = mGrid->indexToVector(mEndCell);
     
-    const auto [aStarTime, aStarPath] = timeIt<std::vector<int>>([this]() {
-        return AStarGrid<int>(mStartCell, mEndCell,
-                              [this](int cell) { return mGrid->getSurrounding(cell); },
-                              [this](int a, int b) { return mGrid->getDistance(a, b); });
+    // The context owns the path so only a pointer is returned. Copying it would add an allocation to the timing.
+    const auto [aStarTime, aStarPath] = timeIt<const std::vector<int>*>([this]() {
+        return &mSearchContext.findPath(*mGrid, mStartCell, mEndCell);
     });
     
     const auto [qTime, qPath] = timeIt<std::vector<int>>([this]() {
@@ -161,12 +231,12 @@ void Scene::updateTestAi()
     
     mTestLog.aStarTimes.emplace_back(aStarTime);
     mTestLog.aiTimes.emplace_back(qTime);
-    mTestLog.aStarPathSize.emplace_back(aStarPath.size());
+    mTestLog.aStarPathSize.emplace_back(aStarPath->size());
     mTestLog.aiPathSize.emplace_back(qPath.size());
     
     for (const auto &node : qPath)
         mGridMesh->setCellColour(mGrid->indexToVector(node), mColours.agent);
-    for (const auto &node : aStarPath)
+    for (const auto &node : *aStarPath)
         mGridMesh->setCellColour(mGrid->indexToVector(node), mColours.path);
     
     if (++mTestNumber >= mNumberOfTests)
@@ -188,8 +258,11 @@ void Scene::moveStartAndFinish()
 
 void Scene::resetGridColour()
 {
-    for (int i = 0; i < mGrid->getCells().size(); ++i)
-        mGridMesh->setCellColour(mGrid->indexToVector(i), mGrid->getCells()[i] == 1 ? mColours.wall : mColours.empty);
+    for (int i = 0; i < mGrid->getCellCount(); ++i)
+    {
+        const bool isWall = mGrid->getCellType(i) == Grid::cellType::Wall;
+        mGridMesh->setCellColour(mGrid->indexToVector(i), isWall ? mColours.wall : mColours.empty);
+    }
 }
 
 void Scene::colourStartAndFinish()
@@ -241,6 +314,17 @@ void Scene::showMainMenuBar()
     }
 }
 
+void Scene::showMazeLoadProgress()
+{
+    if (!mMazeLoader.isRunning())
+        return;
+    
+    const std::string stageName(MazeLoadPipeline::toString(mMazeLoader.getStage()));
+    ImGui::ProgressBar(mMazeLoader.getProgress(), ImVec2(-1.f, 0.f), stageName.c_str());
+    if (ImGui::Button("Cancel Load"))
+        mMazeLoader.cancel();
+}
+
 void Scene::showRadioOptions()
 {
     ImGui::RadioButton("A* Pathfinding", &mOption, AStar);
@@ -295,6 +379,7 @@ void Scene::showSidePanel()
         
         showLogs();
         mMazeExplorer.renderImGui();
+        showMazeLoadProgress();
         showColourSettings();
     }
     
@@ -327,12 +412,21 @@ void Scene::showTestAiSettings()
         mRunTests = true;
     }
     ImGui::Text("Test Number: %llu", mTestNumber);
+    ImGui::Text("A* Queries: %llu", mSearchContext.getStats().queries);
+    ImGui::Text("A* Allocations: %llu", mSearchContext.getStats().allocations);
 }
 
 void Scene::showTrainAiSettings()
 {
     ImGui::Text("Train AI Settings");
     ImGui::Separator();
+    if (mBackgroundTraining != nullptr)
+    {
+        ImGui::Text("Training in the background...");
+        mAiExplorer.renderImGui();
+        return;
+    }
+    
     mPathFinder.renderOptions();
     if (ImGui::Button("Generate New AI"))
     {
@@ -340,6 +434,31 @@ void Scene::showTrainAiSettings()
         mRunTraining = true;
     }
     
+    ImGui::Separator();
+    const int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int threadCount = static_cast<int>(mParallelSettings.threadCount);
+    if (ImGui::SliderInt("Threads (0 = All)", &threadCount, 0, maxThreads))
+        mParallelSettings.threadCount = static_cast<unsigned int>(threadCount);
+    ImGui::Combo("Parallel Mode", reinterpret_cast<int*>(&mParallelSettings.trainingMode), "Hogwild\0Averaged\0");
+    if (mParallelSettings.trainingMode == ParallelTrainer::mode::Averaged)
+        ImGui::DragScalar("Merge Interval", ImGuiDataType_U64, &mParallelSettings.mergeInterval, 10.f);
+    ImGui::Checkbox("Compare With Single Thread", &mCompareParallel);
+    if (ImGui::Button("Train AI In Parallel"))
+        trainAiInParallel();
+    
+    ImGui::Separator();
+    ImGui::DragInt("Batch Agents", &mBatchAgentCount, 16.f, 1, 65536);
+    if (ImGui::Button("Train AI In A Batch"))
+    {
+        startBackgroundTraining([agentCount = mBatchAgentCount](QlPathFinder &pathFinder) {
+            const BatchEnvironment::Stats stats = pathFinder.trainBatched(agentCount);
+            std::stringstream ss;
+            ss << "Batch training. " << static_cast<uint64_t>(stats.stepsPerSecond) << " steps/s, "
+               << stats.successes << " of " << stats.episodes << " episodes reached the goal.";
+            debug::log(ss.str());
+        });
+    }
+    
     mPathFinder.renderTrainingStats();
     mAiExplorer.renderImGui();
 }
@@ -15,8 +15,14 @@
 #include "GridMesh.h"
 #include "RendererSystem.h"
 #include "QlPathFinder.h"
+#include "SearchContext.h"
 #include "FileExplorer.h"
 #include "FileIoCommon.h"
+#include "MazeLoadPipeline.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
 
 /**
  * @brief Colour definitions that are used to render the grid.
@@ -44,15 +50,19 @@ class Scene
             : int {
         AStar, TrainAi, RunAi, TestAi
     };
-    
+
 public:
     explicit Scene(const glm::ivec2 &resolution);
-    ~Scene() = default;
+    
+    /**
+     * @brief Waits for any background training to finish.
+     */
+    ~Scene();
     
     void update();
     void render();
     void renderImGui();
-    
+
 protected:
     /** Enum option for what part of the code should be run. */
     int mOption { 0 };
@@ -60,6 +70,9 @@ protected:
     /** The Q-Learning Pathfinder. A* is a single function */
     QlPathFinder mPathFinder;
     
+    /** Memory reused by every A* query when testing. */
+    SearchContext mSearchContext;
+    
     /** All of the colours that can be renderer to the grid. */
     Colours mColours;
     
@@ -93,8 +106,11 @@ protected:
     /** Index form of the finish position. Used for iterating. */
     int mEndCell { 0 };
     
-    /** An explorer for ImGui to show all of the mazes that can be loaded. */
-    FileExplorer mMazeExplorer { "Mazes", "../res/mazes" };
+    /** Loads mazes in the background. The current maze keeps running until the new one is ready. */
+    MazeLoadPipeline mMazeLoader;
+    
+    /** An explorer for ImGui to show all of the mazes that can be loaded. Caches next to the mazes are hidden. */
+    FileExplorer mMazeExplorer { "Mazes", "../res/mazes", ".txt" };
     
     /** An explorer for ImGui to show all of the Ai 'brains' that can be loaded. */
     FileExplorer mAiExplorer { "AI", "../res/ai" };
@@ -102,6 +118,30 @@ protected:
     /** Determines whether the training cycle should continue or should be aborted. */
     bool mRunTraining { false };
     
+    /** The threads and mode used when training in parallel. */
+    ParallelTrainer::Settings mParallelSettings;
+    
+    /** Also trains a copy of the Ai on a single thread so that parallel training can be compared against it. */
+    bool mCompareParallel { false };
+    
+    /** The number of agents stepped together when training in a batch. */
+    int mBatchAgentCount { 1024 };
+    
+    /**
+     * @brief Training that runs on a worker thread so that the UI keeps drawing. The worker trains its own copy of
+     * the path finder, which replaces mPathFinder once it's done.
+     */
+    struct BackgroundTraining
+    {
+        std::thread                     thread;
+        std::atomic<bool>               isFinished { false };
+        std::shared_ptr<Grid>           grid;  // The grid it was started on. The result is thrown away if it changes.
+        std::unique_ptr<QlPathFinder>   pathFinder;
+    };
+    
+    /** The training that is running in the background. nullptr if there isn't any. */
+    std::unique_ptr<BackgroundTraining> mBackgroundTraining;
+    
     /** Determines whether the testing cycle should continue or should be aborted. */
     bool mRunTests { false };
     
@@ -112,10 +152,10 @@ protected:
     uint64_t mNumberOfTests { 10'000ull };
     
     /**
-     * @brief Attempts to load a maze from the given file path. Sets mIsValidMaze to false it fails.
-     * @param filePath - A path to where the maze is stored.
+     * @brief Replaces the current maze with one that has finished loading and resets training for it.
+     * @param result - The maze given by mMazeLoader.
      */
-    void loadGrid(std::string_view filePath);
+    void swapGrid(MazeLoadPipeline::Result &&result);
     
     /**
      * @brief Performs the A* Algorithm on the loaded grid.
@@ -127,6 +167,27 @@ protected:
      */
     void updateTrainAi();
     
+    /**
+     * @brief Trains the Ai on many threads in the background and logs how it went.
+     */
+    void trainAiInParallel();
+    
+    /**
+     * @brief Starts training a fresh copy of the Ai on a worker thread.
+     * @param job - Trains the copy that it is given. Runs on the worker thread.
+     */
+    void startBackgroundTraining(std::function<void(QlPathFinder&)> job);
+    
+    /**
+     * @brief Swaps in the Ai trained in the background once it has finished.
+     */
+    void pollBackgroundTraining();
+    
+    /**
+     * @brief Saves the Ai and switches to running it.
+     */
+    void finishTraining();
+    
     /**
      * @brief Runs the Ai.
      */
@@ -159,6 +220,7 @@ protected:
     void showColourSettings();
     void showLogs();
     void showMainMenuBar();
+    void showMazeLoadProgress();
     void showRadioOptions();
     void showRunAiSettings();
     void showSidePanel();
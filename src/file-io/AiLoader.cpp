@@ -18,12 +18,17 @@
 void insertQValue(QTable &qTable, std::string_view data)
 {
     const auto splitData = fileSystem::splitArgs(data, ' ');
-    ActionValues values;
+    State state;
+    if (!stringToState(splitData[0], state))
+    {
+        debug::log("Skipping an unknown Q-Table state: " + splitData[0], debug::severity::Minor);
+        return;
+    }
     
     // Convert all the values to floats apart from the first one. The first one is the look-up value.
+    ActionValues &values = qTable[state];
     for (int i = 0; i < values.size(); ++i)
         values[i] = std::stof(splitData[i + 1]);
-    qTable.insert({ splitData[0], values });
 }
 
 fileSystem::aiSymbols fileSystem::loadAi(std::string_view path)
@@ -45,6 +50,7 @@ fileSystem::aiSymbols fileSystem::loadAi(std::string_view path)
             { "#xm", [&info](std::string_view data){ info.explorationRateMin    = std::stof(data.data()); } },
             { "#al", [&info](std::string_view data){ info.alpha                 = std::stof(data.data()); } },
             { "#ga", [&info](std::string_view data){ info.gamma                 = std::stof(data.data()); } },
+            { "#la", [&info](std::string_view data){ info.lambda                = std::stof(data.data()); } },
             { "#qt", [&info](std::string_view data){ insertQValue(info.qTable, data); } },
     };
     
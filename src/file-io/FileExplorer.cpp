@@ -10,15 +10,15 @@
 
 #include <imgui.h>
 
-FileExplorer::FileExplorer(std::string_view explorerName, std::string_view filePath)
-    : mExplorerName(explorerName), mFilePath(filePath)
+FileExplorer::FileExplorer(std::string_view explorerName, std::string_view filePath, std::string_view extension)
+    : mExplorerName(explorerName), mFilePath(filePath), mExtension(extension)
 {
     update();
 }
 
 void FileExplorer::update()
 {
-    mPathItems = fileSystem::ls(mFilePath);
+    mPathItems = fileSystem::ls(mFilePath, mExtension);
     mIndex = -1;
 }
 
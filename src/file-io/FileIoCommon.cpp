@@ -11,11 +11,13 @@
 #include <fstream>
 #include <string_view>
 
-std::vector<std::string> fileSystem::ls(std::string_view path)
+std::vector<std::string> fileSystem::ls(std::string_view path, std::string_view extension)
 {
     std::vector<std::string> out;
     for (const auto &entry : std::filesystem::directory_iterator(path.data()))
     {
+        if (!extension.empty() && entry.path().extension().string() != extension)
+            continue;
         if (isValidPath(entry.path().string()))
             out.emplace_back(entry.path().filename().string());
     }
@@ -0,0 +1,143 @@
+/**
+ * @file GridCache.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "GridCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    constexpr uint32_t cacheMagic = 0x48434347;  // "GCCH"
+    
+    /**
+     * @brief The start of a cache file. The wall distances then the move masks follow straight after it.
+     */
+    struct CacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t hash;          // The maze that the tables were built from, see hashMaze().
+        uint64_t tablesHash;    // The tables themselves, see hashTables().
+        int32_t  width;
+        int32_t  height;
+    };
+    
+    constexpr uint64_t fnvOffsetBasis = 0xcbf29ce484222325ull;
+    constexpr uint64_t fnvPrime       = 0x100000001b3ull;
+    
+    uint64_t fnv1a(uint64_t hash, const void *bytes, size_t count)
+    {
+        const auto *byte = static_cast<const uint8_t*>(bytes);
+        for (size_t i = 0; i < count; ++i)
+        {
+            hash ^= byte[i];
+            hash *= fnvPrime;
+        }
+        return hash;
+    }
+    
+    /**
+     * @brief FNV-1a over 64 bit words instead of bytes. Much quicker than fnv1a() on tables of a large maze.
+     */
+    uint64_t fnv1aWords(uint64_t hash, const void *bytes, size_t count)
+    {
+        const auto *byte = static_cast<const uint8_t*>(bytes);
+        const size_t wordBytes = count - count % sizeof(uint64_t);
+        for (size_t i = 0; i < wordBytes; i += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, byte + i, sizeof(uint64_t));
+            hash ^= word;
+            hash *= fnvPrime;
+        }
+        return fnv1a(hash, byte + wordBytes, count - wordBytes);
+    }
+    
+    uint64_t hashTables(const Grid::Tables &tables, size_t cellCount)
+    {
+        const uint64_t hash = fnv1aWords(fnvOffsetBasis, tables.wallDistances, cellCount * sizeof(Grid::WallDistances));
+        return fnv1aWords(hash, tables.moveMasks, cellCount * sizeof(uint8_t));
+    }
+}
+
+uint64_t fileSystem::hashMaze(const fileSystem::MazeData &data)
+{
+    uint64_t hash = fnv1a(fnvOffsetBasis, &data.gridSize, sizeof(data.gridSize));
+    return fnv1a(hash, data.grid.data(), data.grid.size() * sizeof(int));
+}
+
+std::string fileSystem::getGridCachePath(std::string_view mazePath)
+{
+    return std::string(mazePath) + ".cache";
+}
+
+std::shared_ptr<Grid> fileSystem::loadGridCache(std::string_view mazePath, const fileSystem::MazeData &data)
+{
+    std::ifstream file(getGridCachePath(mazePath), std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return nullptr;
+    
+    const size_t cellCount = data.grid.size();
+    const auto expectedSize = static_cast<std::streamoff>(
+            sizeof(CacheHeader) + cellCount * (sizeof(Grid::WallDistances) + sizeof(uint8_t)));
+    if (file.tellg() != expectedSize)
+        return nullptr;
+    
+    CacheHeader header {};
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(&header), sizeof(CacheHeader));
+    if (!file.good() || header.magic != cacheMagic || header.version != gridCacheVersion
+        || header.hash != hashMaze(data) || header.width != data.gridSize.x || header.height != data.gridSize.y)
+        return nullptr;  // Stale or from a different maze.
+    
+    // Grid keeps its own copy of the tables, so they're read rather than mapped.
+    std::vector<Grid::WallDistances> wallDistances(cellCount);
+    std::vector<uint8_t> moveMasks(cellCount);
+    file.read(reinterpret_cast<char*>(wallDistances.data()), cellCount * sizeof(Grid::WallDistances));
+    file.read(reinterpret_cast<char*>(moveMasks.data()), cellCount * sizeof(uint8_t));
+    
+    const Grid::Tables tables { wallDistances.data(), moveMasks.data() };
+    if (!file.good() || hashTables(tables, cellCount) != header.tablesHash)
+        return nullptr;  // Corrupt. A bad move mask could send an agent outside of the grid.
+    
+    return std::make_shared<Grid>(data.grid, data.gridSize.x, tables);
+}
+
+bool fileSystem::saveGridCache(std::string_view mazePath, const fileSystem::MazeData &data, const Grid &grid)
+{
+    const std::string path = getGridCachePath(mazePath);
+    const std::string temporaryPath = path + ".tmp";
+    
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return false;
+        
+        const Grid::Tables tables = grid.getTables();
+        const size_t cellCount = static_cast<size_t>(grid.getCellCount());
+        const CacheHeader header {
+            cacheMagic, gridCacheVersion, hashMaze(data), hashTables(tables, cellCount),
+            data.gridSize.x, data.gridSize.y
+        };
+        
+        file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+        file.write(reinterpret_cast<const char*>(tables.wallDistances), cellCount * sizeof(Grid::WallDistances));
+        file.write(reinterpret_cast<const char*>(tables.moveMasks), cellCount * sizeof(uint8_t));
+        if (!file.good())
+        {
+            file.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+    
+    // Written to the side and then renamed so that a reader never maps a half written cache.
+    std::remove(path.c_str());
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
@@ -0,0 +1,415 @@
+/**
+ * @file Headless.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "Headless.h"
+
+#include "MazeLoader.h"
+#include "GridCache.h"
+#include "FileIoCommon.h"
+#include "Common.h"
+#include "Random.h"
+
+#include <charconv>
+#include <tuple>
+
+namespace
+{
+    template<typename T>
+    bool parseNumber(std::string_view text, T &out)
+    {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return error == std::errc() && end == text.data() + text.size();
+    }
+    
+    bool parseSampling(std::string_view text, ReplayBuffer::sampling &out)
+    {
+        if (text == "uniform")
+            out = ReplayBuffer::sampling::Uniform;
+        else if (text == "prioritised")
+            out = ReplayBuffer::sampling::Prioritised;
+        else
+            return false;
+        return true;
+    }
+    
+    bool parseSwitch(std::string_view text, bool &out)
+    {
+        if (text == "on")
+            out = true;
+        else if (text == "off")
+            out = false;
+        else
+            return false;
+        return true;
+    }
+    
+    void printParallelStats(std::string_view name, const ParallelTrainer::Stats &stats)
+    {
+        std::cout << name << ", " << stats.threadCount << " thread(s): "
+                  << static_cast<uint64_t>(stats.episodesPerSecond) << " episodes/s over " << stats.seconds << "s. "
+                  << stats.successRate * 100.f << "% reached the goal in " << stats.meanSteps << " steps on average.\n";
+    }
+    
+    bool parseParallelMode(std::string_view text, ParallelTrainer::mode &out)
+    {
+        if (text == "hogwild")
+            out = ParallelTrainer::mode::Hogwild;
+        else if (text == "averaged")
+            out = ParallelTrainer::mode::Averaged;
+        else
+            return false;
+        return true;
+    }
+    
+    bool parseMode(std::string_view text, Headless::trainingMode &out)
+    {
+        static const std::unordered_map<std::string_view, Headless::trainingMode> modes {
+                { "none",     Headless::trainingMode::None },
+                { "single",   Headless::trainingMode::Single },
+                { "parallel", Headless::trainingMode::Parallel },
+                { "batch",    Headless::trainingMode::Batch },
+        };
+        
+        const auto it = modes.find(text);
+        if (it == modes.end())
+            return false;
+        out = it->second;
+        return true;
+    }
+    
+    template<typename T>
+    double mean(const std::vector<T> &values)
+    {
+        if (values.empty())
+            return 0.0;
+        return static_cast<double>(std::accumulate(values.begin(), values.end(), T(0))) / static_cast<double>(values.size());
+    }
+}
+
+Headless::Headless(const std::vector<std::string_view> &arguments)
+{
+    parseArguments(arguments);
+}
+
+int Headless::run()
+{
+    if (!mIsValid)
+    {
+        printUsage();
+        return 1;
+    }
+    
+    debug::clearLogs();
+    if (!loadGrid())
+    {
+        std::cout << "Could not load the maze: " << mSettings.mazePath << "\n";
+        return 1;
+    }
+    
+    // Always reseeded so that a printed seed given back with --seed repeats the run exactly.
+    setRandomSeed(mSettings.seed != 0 ? mSettings.seed : getRandomSeed());
+    std::cout << "Random seed: " << getRandomSeed() << "\n";
+    
+    mPathFinder.setConvergenceSettings(mSettings.convergence);
+    mPathFinder.setPairSchedulerSettings(mSettings.curriculum);
+    mPathFinder.init(mGrid);
+    if (!mSettings.aiPath.empty())
+        mPathFinder.loadAi(mSettings.aiPath);
+    if (mSettings.episodes > 0)
+        mPathFinder.setEpisodeMax(mSettings.episodes);
+    if (mSettings.iterations > 0)
+        mPathFinder.setIterationMax(mSettings.iterations);
+    
+    if (mSettings.lambda >= 0.f)
+        mPathFinder.setTraceDecay(mSettings.lambda);
+    
+    if (mSettings.replayKilobytes > 0)
+    {
+        const size_t bytes = mSettings.replayKilobytes * 1024;
+        mSettings.replay.capacity = ReplayBuffer::capacityForBytes(bytes, mSettings.replay.samplingMode);
+    }
+    mPathFinder.setReplaySettings(mSettings.replay);
+    mPathFinder.setPlanningSteps(mSettings.planningSteps);
+    
+    if (mSettings.mode != trainingMode::None)
+    {
+        train();
+        const auto saveName = getUniqueString() + ".txt";
+        mPathFinder.saveAi(mSettings.saveFolder, saveName);
+        std::cout << "Saved the Ai to: " << mSettings.saveFolder << saveName << "\n";
+    }
+    
+    if (mSettings.testCount > 0)
+        compare();
+    
+    return 0;
+}
+
+void Headless::printUsage()
+{
+    std::cout << "Usage: A2AiGameProgrammingHeadless --maze <path> [options]\n"
+              << "  --maze <path>        The maze file to load.\n"
+              << "  --ai <path>          Loads an Ai instead of making a new one. Skips training unless --mode is given.\n"
+              << "  --mode <mode>        none, single, parallel (default) or batch.\n"
+              << "  --episodes <n>       Number of training episodes.\n"
+              << "  --iterations <n>     Maximum steps per episode.\n"
+              << "  --threads <n>        Threads for parallel training. 0 uses every hardware thread.\n"
+              << "  --parallel-mode <s>  hogwild (default) or averaged. Hogwild threads race on one table, so it\n"
+              << "                       ignores --seed. Averaged merges thread copies and repeats with --seed.\n"
+              << "  --merge-interval <n> Episodes per thread between merges (averaged only).\n"
+              << "  --compare-serial <s> on or off (default). Also trains a copy of the Ai single threaded, so that\n"
+              << "                       parallel training can be compared with it on the same greedy pairs.\n"
+              << "  --agents <n>         Agents stepped at once for batch training.\n"
+              << "  --seed <n>           Master random seed. 0 (default) picks one and prints it. Repeats every mode\n"
+              << "                       except hogwild parallel training.\n"
+              << "  --lambda <x>         Q(lambda) trace decay [0, 1] (single only). 0 is one step Q-learning.\n"
+              << "  --replay <n>         Experience replay capacity in transitions (single only). 0 turns it off.\n"
+              << "  --replay-kb <n>      Sizes the experience replay buffer to fit in n kilobytes instead.\n"
+              << "  --replay-batch <n>   Transitions replayed per batch.\n"
+              << "  --replay-every <n>   Steps between replayed batches.\n"
+              << "  --replay-sampling <s> uniform (default) or prioritised.\n"
+              << "  --planning <n>       Dyna-Q planning updates per real step (single only). 0 turns it off.\n"
+              << "  --early-stop <s>     on or off (default). Lets single threaded training stop once it converges.\n"
+              << "  --stop-delta <x>     Converged once every episode's max |dQ| is below x...\n"
+              << "  --stop-patience <n>  ...for n episodes in a row. 0 turns it off.\n"
+              << "  --stop-success <x>   Stop once the recent episode success rate reaches x. Above 1 (default) is off.\n"
+              << "  --stop-eval <x>      Stop once the greedy success rate on the fixed evaluation pairs reaches x.\n"
+              << "  --eval-every <n>     Episodes between greedy evaluations. 0 turns them off.\n"
+              << "  --curriculum <s>     on or off (default). Picks single threaded training pairs from short to long,\n"
+              << "                       favouring the ones that have been failing.\n"
+              << "  --ramp <x>           Fraction of the episodes it takes the curriculum to unlock every distance.\n"
+              << "  --fail-boost <x>     How much more a failing pair is picked than one that succeeds.\n"
+              << "  --tests <n>          Number of A* vs Ai comparisons to run. 0 skips them.\n"
+              << "  --save <folder>      Where the trained Ai is saved (default ../res/ai/).\n"
+              << "  --results <path>     Where the comparison is saved (default ../res/test-data/results.txt).\n";
+}
+
+void Headless::parseArguments(const std::vector<std::string_view> &arguments)
+{
+    bool isModeSet = false;
+    for (size_t i = 0; i < arguments.size() && mIsValid; ++i)
+    {
+        const std::string_view option = arguments[i];
+        if (option == "--help" || option == "-h" || i + 1 >= arguments.size())
+        {
+            mIsValid = false;
+            break;
+        }
+        
+        const std::string_view value = arguments[++i];
+        if (option == "--maze")
+            mSettings.mazePath = value;
+        else if (option == "--ai")
+            mSettings.aiPath = value;
+        else if (option == "--save")
+            mSettings.saveFolder = value;
+        else if (option == "--results")
+            mSettings.resultsPath = value;
+        else if (option == "--mode")
+            mIsValid = isModeSet = parseMode(value, mSettings.mode);
+        else if (option == "--episodes")
+            mIsValid = parseNumber(value, mSettings.episodes);
+        else if (option == "--iterations")
+            mIsValid = parseNumber(value, mSettings.iterations);
+        else if (option == "--threads")
+            mIsValid = parseNumber(value, mSettings.threadCount);
+        else if (option == "--parallel-mode")
+            mIsValid = parseParallelMode(value, mSettings.parallelMode);
+        else if (option == "--merge-interval")
+            mIsValid = parseNumber(value, mSettings.mergeInterval) && mSettings.mergeInterval > 0;
+        else if (option == "--compare-serial")
+            mIsValid = parseSwitch(value, mSettings.isComparingSerial);
+        else if (option == "--agents")
+            mIsValid = parseNumber(value, mSettings.agentCount) && mSettings.agentCount > 0;
+        else if (option == "--seed")
+            mIsValid = parseNumber(value, mSettings.seed);
+        else if (option == "--lambda")
+            mIsValid = parseNumber(value, mSettings.lambda) && mSettings.lambda >= 0.f && mSettings.lambda <= 1.f;
+        else if (option == "--replay")
+            mIsValid = parseNumber(value, mSettings.replay.capacity);
+        else if (option == "--replay-kb")
+            mIsValid = parseNumber(value, mSettings.replayKilobytes);
+        else if (option == "--replay-batch")
+            mIsValid = parseNumber(value, mSettings.replay.batchSize);
+        else if (option == "--replay-every")
+            mIsValid = parseNumber(value, mSettings.replay.replayInterval);
+        else if (option == "--replay-sampling")
+            mIsValid = parseSampling(value, mSettings.replay.samplingMode);
+        else if (option == "--planning")
+            mIsValid = parseNumber(value, mSettings.planningSteps) && mSettings.planningSteps >= 0;
+        else if (option == "--early-stop")
+            mIsValid = parseSwitch(value, mSettings.convergence.isEnabled);
+        else if (option == "--stop-delta")
+            mIsValid = parseNumber(value, mSettings.convergence.deltaThreshold);
+        else if (option == "--stop-patience")
+            mIsValid = parseNumber(value, mSettings.convergence.deltaPatience);
+        else if (option == "--stop-success")
+            mIsValid = parseNumber(value, mSettings.convergence.successThreshold);
+        else if (option == "--stop-eval")
+            mIsValid = parseNumber(value, mSettings.convergence.evaluationTarget);
+        else if (option == "--eval-every")
+            mIsValid = parseNumber(value, mSettings.convergence.evaluationInterval);
+        else if (option == "--curriculum")
+            mIsValid = parseSwitch(value, mSettings.curriculum.isEnabled);
+        else if (option == "--ramp")
+            mIsValid = parseNumber(value, mSettings.curriculum.rampFraction) && mSettings.curriculum.rampFraction > 0.f;
+        else if (option == "--fail-boost")
+            mIsValid = parseNumber(value, mSettings.curriculum.failureBoost) && mSettings.curriculum.failureBoost >= 0.f;
+        else if (option == "--tests")
+            mIsValid = parseNumber(value, mSettings.testCount);
+        else
+            mIsValid = false;
+        
+        if (!mIsValid)
+            std::cout << "Invalid argument: " << option << " " << value << "\n";
+    }
+    
+    if (!mSettings.aiPath.empty() && !isModeSet)
+        mSettings.mode = trainingMode::None;
+    mIsValid = mIsValid && !mSettings.mazePath.empty();
+}
+
+bool Headless::loadGrid()
+{
+    const auto data = fileSystem::loadMaze(mSettings.mazePath);
+    if (data.grid.empty())
+        return false;
+    
+    mGrid = fileSystem::loadGridCache(mSettings.mazePath, data);
+    if (mGrid == nullptr)
+    {
+        mGrid = std::make_shared<Grid>(data.grid, data.gridSize.x);
+        fileSystem::saveGridCache(mSettings.mazePath, data, *mGrid);
+    }
+    
+    if (mGrid->getFreeCells().count() < 2)
+        return false;
+    
+    mEndCell = mGrid->moveToNextValidCell(0);
+    mStartCell = mGrid->moveToNextValidCell(mEndCell);
+    std::cout << "Loaded " << mSettings.mazePath << " (" << mGrid->getSize().x << "x" << mGrid->getSize().y << ")\n";
+    return true;
+}
+
+void Headless::train()
+{
+    std::cout << "Training for " << mPathFinder.getEpisodeMax() << " episodes...\n";
+    switch (mSettings.mode)
+    {
+        case trainingMode::Single:
+        {
+            const auto startTime = std::chrono::steady_clock::now();
+            const bool isScheduled = mPathFinder.getPairScheduler().isActive();
+            while (!mPathFinder.isTrainingFinished())
+            {
+                if (isScheduled)
+                {
+                    std::ignore = mPathFinder.trainScheduledPath();
+                    continue;
+                }
+                moveStartAndFinish();
+                std::ignore = mPathFinder.trainPath(mGrid->indexToVector(mStartCell), mGrid->indexToVector(mEndCell));
+            }
+            const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - startTime;
+            const ConvergenceTracker::Stats &stats = mPathFinder.getConvergence().getStats();
+            std::cout << "1 thread: " << static_cast<uint64_t>(static_cast<double>(stats.episodes) / seconds.count())
+                      << " episodes/s over " << seconds.count() << "s.\n"
+                      << "Stopped after " << stats.episodes << " episodes: "
+                      << ConvergenceTracker::toString(stats.reason) << ".\n"
+                      << "  Last episode |dQ|: max " << stats.lastMaxDelta << ", mean " << stats.lastMeanDelta << "\n"
+                      << "  Recent success rate: " << stats.windowSuccessRate * 100.f << "%\n";
+            if (stats.evaluations > 0)
+                std::cout << "  Greedy success rate: " << stats.lastEvaluation.successRate * 100.f << "% (best "
+                          << stats.bestEvaluation.successRate * 100.f << "%) over " << stats.evaluations
+                          << " evaluations\n";
+            if (mSettings.replay.capacity > 0)
+                std::cout << "Experience replay: " << mSettings.replay.capacity << " transitions in "
+                          << mPathFinder.getReplayBuffer().getMemoryUsage() / 1024 << "KB.\n";
+            if (isScheduled)
+                std::cout << "Curriculum: " << mPathFinder.getPairScheduler().getPairCount() << " pairs up to "
+                          << mPathFinder.getPairScheduler().getUnlockedDistance() << " steps apart.\n";
+            if (mSettings.planningSteps > 0)
+                std::cout << "Dyna-Q: " << mSettings.planningSteps << " planning updates per step from "
+                          << mPathFinder.getModel().getSeenCount() << " learned state-action pairs.\n";
+            break;
+        }
+        case trainingMode::Parallel:
+        {
+            ParallelTrainer::Settings settings;
+            settings.threadCount = mSettings.threadCount;
+            settings.trainingMode = mSettings.parallelMode;
+            settings.mergeInterval = mSettings.mergeInterval;
+            if (mSettings.isComparingSerial)
+            {
+                auto serial = std::make_unique<QlPathFinder>(mPathFinder);
+                printParallelStats("Single threaded", serial->trainSerial());
+            }
+            printParallelStats("Parallel", mPathFinder.trainParallel(settings));
+            break;
+        }
+        case trainingMode::Batch:
+        {
+            const BatchEnvironment::Stats stats = mPathFinder.trainBatched(mSettings.agentCount);
+            std::cout << mSettings.agentCount << " agent(s): " << static_cast<uint64_t>(stats.stepsPerSecond)
+                      << " steps/s over " << stats.seconds << "s. " << stats.successes << "/" << stats.episodes
+                      << " episodes reached the goal.\n";
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void Headless::compare()
+{
+    fileSystem::TestLog testLog;
+    testLog.aStarTimes.reserve(mSettings.testCount);
+    testLog.aiTimes.reserve(mSettings.testCount);
+    testLog.aStarPathSize.reserve(mSettings.testCount);
+    testLog.aiPathSize.reserve(mSettings.testCount);
+    uint64_t successes = 0;
+    
+    for (uint64_t i = 0; i < mSettings.testCount; ++i)
+    {
+        moveStartAndFinish();
+        const glm::ivec2 startPos = mGrid->indexToVector(mStartCell);
+        const glm::ivec2 endPos   = mGrid->indexToVector(mEndCell);
+        
+        // The context owns the path so only a pointer is returned. Copying it would add an allocation to the timing.
+        const auto [aStarTime, aStarPath] = timeIt<const std::vector<int>*>([this]() {
+            return &mSearchContext.findPath(*mGrid, mStartCell, mEndCell);
+        });
+        
+        const auto [qTime, qPath] = timeIt<std::vector<int>>([&]() {
+            return mPathFinder.calculatePath(startPos, endPos);
+        });
+        
+        testLog.aStarTimes.emplace_back(aStarTime);
+        testLog.aiTimes.emplace_back(qTime);
+        testLog.aStarPathSize.emplace_back(aStarPath->size());
+        testLog.aiPathSize.emplace_back(qPath.size());
+        successes += qPath.back() == mEndCell;
+    }
+    
+    fileSystem::saveTestData(mSettings.resultsPath, testLog);
+    
+    const double successRate = 100.0 * static_cast<double>(successes) / static_cast<double>(mSettings.testCount);
+    std::cout << "Compared " << mSettings.testCount << " paths (results saved to " << mSettings.resultsPath << ")\n"
+              << "  A*: " << mean(testLog.aStarTimes) << "us, " << mean(testLog.aStarPathSize) << " cells on average.\n"
+              << "  Ai: " << mean(testLog.aiTimes)    << "us, " << mean(testLog.aiPathSize)    << " cells on average, "
+              << successRate << "% reached the goal.\n";
+}
+
+void Headless::moveStartAndFinish()
+{
+    int temp = mGrid->moveToNextValidCell(mStartCell);
+    if (temp < mStartCell)
+        mEndCell = mGrid->moveToNextValidCell(mEndCell);
+    if (temp == mEndCell)
+        temp = mGrid->moveToNextValidCell(mStartCell);
+    mStartCell = temp;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file Headless.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "Grid.h"
+#include "QlPathFinder.h"
+#include "SearchContext.h"
+
+/**
+ * Trains, saves and tests an Ai without a window so that it can run as fast as the CPU allows.
+ * Mirrors what the Scene does, one whole run per call to run() rather than one episode per frame.
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+class Headless
+{
+public:
+    enum class trainingMode : unsigned char { None, Single, Parallel, Batch };
+    
+    struct Settings
+    {
+        std::string  mazePath;
+        std::string  aiPath;                                    // Loads this Ai instead of making a new one.
+        std::string  saveFolder         { "../res/ai/" };
+        std::string  resultsPath        { "../res/test-data/results.txt" };
+        trainingMode mode               { trainingMode::Parallel };
+        uint64_t     episodes           { 0 };                  // 0 keeps the Ai's own value.
+        uint64_t     iterations         { 0 };                  // 0 keeps the Ai's own value.
+        unsigned int threadCount        { 0 };                  // 0 uses the number of hardware threads.
+        ParallelTrainer::mode parallelMode { ParallelTrainer::mode::Hogwild };
+        uint64_t     mergeInterval      { 100 };                // Episodes per worker between merges. Averaged only.
+        bool         isComparingSerial  { false };              // Trains a copy single threaded first. Parallel only.
+        int          agentCount         { 256 };
+        uint64_t     testCount          { 1'000ull };
+        uint64_t     seed               { 0 };                  // 0 picks a random one.
+        float        lambda             { -1.f };               // Below 0 keeps the Ai's own value.
+        uint64_t     replayKilobytes    { 0 };                  // Sizes the replay buffer by memory instead.
+        int          planningSteps      { 0 };                  // Dyna-Q updates per real step. Single only.
+        ReplayBuffer::Settings replay;                          // Single threaded training only.
+        ConvergenceTracker::Settings convergence;               // Single threaded training only.
+        PairScheduler::Settings curriculum;                     // Single threaded training only.
+    };
+
+public:
+    /**
+     * @param arguments - The command line arguments (without the program name). See printUsage().
+     */
+    explicit Headless(const std::vector<std::string_view> &arguments);
+    
+    /**
+     * @brief Loads the maze, trains (or loads) the Ai, saves it and compares it against A*.
+     * @returns The exit code of the program.
+     */
+    int run();
+    
+    /** Prints the command line arguments that can be given to the program. */
+    static void printUsage();
+
+protected:
+    Settings                mSettings;
+    std::shared_ptr<Grid>   mGrid;
+    QlPathFinder            mPathFinder;
+    SearchContext           mSearchContext;
+    int                     mStartCell  { 0 };
+    int                     mEndCell    { 0 };
+    bool                    mIsValid    { true };
+    
+    /**
+     * @brief Parses the command line arguments into mSettings. mIsValid is false if any of them are bad.
+     * @param arguments - The command line arguments (without the program name).
+     */
+    void parseArguments(const std::vector<std::string_view> &arguments);
+    
+    /**
+     * @brief Loads the maze from mSettings.mazePath, using the cache next to it if it's still valid.
+     * @returns True if success, false otherwise.
+     */
+    bool loadGrid();
+    
+    /** Trains the Ai based on mSettings.mode. */
+    void train();
+    
+    /** Times A* against the Ai between every pair of cells that the Scene's test would use. */
+    void compare();
+    
+    /** Steps the start and end cell the same way as the Scene so that the results match. */
+    void moveStartAndFinish();
+};
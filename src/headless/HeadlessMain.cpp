@@ -0,0 +1,16 @@
+#include "Headless.h"
+
+int main(int argc, char *argv[])
+{
+    const std::vector<std::string_view> arguments(argv + 1, argv + argc);
+    try
+    {
+        Headless headless(arguments);
+        return headless.run();
+    }
+    catch (const std::exception &exception)
+    {
+        std::cout << exception.what() << "\n";
+        return 1;
+    }
+}
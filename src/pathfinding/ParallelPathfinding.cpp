@@ -0,0 +1,203 @@
+/**
+ * @file ParallelPathfinding.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "ParallelPathfinding.h"
+
+#include "Grid.h"
+#include "Pathfinding.h"
+#include "MpscQueue.h"
+#include "Common.h"
+
+#include <atomic>
+#include <thread>
+
+namespace
+{
+    /**
+     * @brief A node that is sent to the worker that owns it.
+     */
+    struct Message
+    {
+        int cell    { -1 };
+        int parent  { -1 };
+        float gScore { 0.f };
+    };
+    
+    /**
+     * @brief Everything a single HDA* thread owns. Only the owning thread touches it while searching.
+     */
+    struct Worker
+    {
+        MpscQueue<Message>                inbox;
+        std::priority_queue<FNode<int>>   openSet;
+        std::unordered_map<int, float>    gScore;
+        std::unordered_map<int, int>      cameFrom;
+    };
+    
+    /**
+     * @brief The state shared between all of the workers.
+     */
+    struct SharedSearch
+    {
+        const Grid &grid;
+        const int end;
+        std::vector<std::unique_ptr<Worker>> workers { };
+        
+        /** Length of the best path found so far. */
+        std::atomic<float> incumbent { std::numeric_limits<float>::infinity() };
+        
+        /**
+         * Number of busy workers plus the number of messages in flight. A worker always marks itself busy before
+         * a message it received is counted as consumed, so this can only reach zero once no work is left.
+         */
+        std::atomic<int64_t> work { 0 };
+        
+        std::atomic<bool> isFinished { false };
+        
+        [[nodiscard]] unsigned int ownerOf(int cell) const
+        {
+            // Multiplicative hashing spreads neighbouring cells across workers to balance the load.
+            const uint32_t hash = static_cast<uint32_t>(cell) * 2654435761u;
+            return (hash >> 16) % static_cast<uint32_t>(workers.size());
+        }
+        
+        [[nodiscard]] float heuristic(int cell) const
+        {
+            // max(∆x, ∆y) never overestimates when every move (including diagonals) costs one.
+            return static_cast<float>(grid.getDiagonalDistance(cell, end));
+        }
+        
+        void offerIncumbent(float cost)
+        {
+            float current = incumbent.load();
+            while (cost < current && !incumbent.compare_exchange_weak(current, cost));
+        }
+    };
+    
+    /**
+     * @brief Relaxes a node that belongs to the worker. Adds it to the open set if it improves the gScore.
+     */
+    void relax(SharedSearch &search, Worker &worker, const Message &message)
+    {
+        auto it = worker.gScore.find(message.cell);
+        if (it != worker.gScore.end() && it->second <= message.gScore)
+            return;
+        
+        worker.gScore[message.cell] = message.gScore;
+        if (message.parent >= 0)
+            worker.cameFrom[message.cell] = message.parent;
+        worker.openSet.push({ message.cell, message.gScore + search.heuristic(message.cell) });
+    }
+    
+    void runWorker(SharedSearch &search, unsigned int id)
+    {
+        Worker &worker = *search.workers[id];
+        bool isBusy = true;  // Every worker starts busy, see SharedSearch::work.
+        
+        while (!search.isFinished.load(std::memory_order_acquire))
+        {
+            Message message;
+            while (worker.inbox.pop(message))
+            {
+                if (!isBusy)
+                {
+                    search.work.fetch_add(1);
+                    isBusy = true;
+                }
+                relax(search, worker, message);
+                search.work.fetch_sub(1);  // The message has been consumed.
+            }
+            
+            const float incumbent = search.incumbent.load();
+            if (!worker.openSet.empty() && worker.openSet.top().fScore < incumbent)
+            {
+                const FNode<int> current = worker.openSet.top();
+                worker.openSet.pop();
+                
+                const float gScore = worker.gScore[current.node];
+                if (current.fScore > gScore + search.heuristic(current.node))
+                    continue;  // A better route to this node has been found since it was queued.
+                
+                if (current.node == search.end)
+                {
+                    search.offerIncumbent(gScore);
+                    continue;
+                }
+                
+                uint32_t moves = search.grid.getMoveMask(current.node);
+                for (; moves != 0; moves &= moves - 1)
+                {
+                    const int adjacent = search.grid.getNeighbour(current.node, countTrailingZeros(moves));
+                    const Message next { adjacent, current.node, gScore + 1.f };
+                    if (next.gScore + search.heuristic(adjacent) >= incumbent)
+                        continue;  // Can never beat the current best path.
+                    
+                    const unsigned int owner = search.ownerOf(adjacent);
+                    if (owner == id)
+                    {
+                        relax(search, worker, next);
+                        continue;
+                    }
+                    
+                    search.work.fetch_add(1);
+                    search.workers[owner]->inbox.push(next);
+                }
+                continue;
+            }
+            
+            // Nothing left that could improve the incumbent.
+            if (isBusy)
+            {
+                isBusy = false;
+                search.work.fetch_sub(1);
+            }
+            
+            if (search.work.load() == 0)
+                search.isFinished.store(true, std::memory_order_release);
+            else
+                std::this_thread::yield();
+        }
+    }
+}
+
+std::vector<int> ParallelAStarGrid(const Grid &grid, int start, int end, unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = glm::max(1u, std::thread::hardware_concurrency());
+    
+    SharedSearch search { grid, end };
+    for (unsigned int i = 0; i < threadCount; ++i)
+        search.workers.emplace_back(std::make_unique<Worker>());
+    search.work = static_cast<int64_t>(threadCount);
+    
+    relax(search, *search.workers[search.ownerOf(start)], { start, -1, 0.f });
+    
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < threadCount; ++i)
+        threads.emplace_back(runWorker, std::ref(search), i);
+    runWorker(search, 0);  // The calling thread does its share of the work too.
+    for (auto &thread : threads)
+        thread.join();
+    
+    if (search.incumbent.load() == std::numeric_limits<float>::infinity())
+    {
+        debug::log("Failed to find path between the two points", debug::severity::Minor);
+        return { };
+    }
+    
+    // The path is spread across the workers, so follow it back through whoever owns each cell.
+    std::vector<int> path { end };
+    int current = end;
+    while (current != start)
+    {
+        const auto &cameFrom = search.workers[search.ownerOf(current)]->cameFrom;
+        current = cameFrom.at(current);
+        path.push_back(current);
+    }
+    
+    return std::vector<int>(path.rbegin(), path.rend());
+}
@@ -0,0 +1,339 @@
+/**
+ * @file RectangleGraph.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "RectangleGraph.h"
+
+#include "Grid.h"
+#include "Pathfinding.h"
+
+#include <set>
+
+namespace
+{
+    [[nodiscard]] int diagonalDistance(const glm::ivec2 &a, const glm::ivec2 &b)
+    {
+        const auto diffVec = glm::abs(a - b);
+        return glm::max(diffVec.x, diffVec.y);
+    }
+    
+    /**
+     * @brief Walks from a to b (not including a) with diagonal steps first. Only valid when every cell in the
+     * bounding box of a and b is empty, which is always true inside of a rectangle.
+     */
+    void walk(glm::ivec2 a, const glm::ivec2 &b, int width, std::vector<int> &path)
+    {
+        while (a != b)
+        {
+            a += glm::sign(b - a);
+            path.push_back(a.x + a.y * width);
+        }
+    }
+}
+
+RectangleGraph::RectangleGraph(const Grid &grid)
+{
+    rebuild(grid);
+}
+
+void RectangleGraph::rebuild(const Grid &grid)
+{
+    mSize = grid.getSize();
+    mVersion = grid.getVersion();
+    mOwners.assign(static_cast<size_t>(mSize.x) * mSize.y, -1);
+    mRectangles.clear();
+    mPortals.clear();
+    mFreeIds.clear();
+    
+    for (int id : decompose(grid, glm::ivec2(0), mSize - glm::ivec2(1)))
+        connect(id);
+}
+
+void RectangleGraph::sync(const Grid &grid)
+{
+    if (grid.getVersion() == mVersion)
+        return;
+    
+    std::vector<Grid::Change> changes;
+    if (!grid.changesSince(mVersion, changes))
+    {
+        rebuild(grid);
+        return;
+    }
+    
+    for (const Grid::Change &change : changes)
+        onCellsChanged(grid, change.min, change.max);
+    mVersion = grid.getVersion();
+}
+
+void RectangleGraph::onCellsChanged(const Grid &grid, const glm::ivec2 &min, const glm::ivec2 &max)
+{
+    // Anything overlapping the change is thrown away. The area that needs decomposing again is every cell that
+    // belonged to those rectangles plus the changed cells themselves.
+    glm::ivec2 regionMin = glm::clamp(min, glm::ivec2(0), mSize - glm::ivec2(1));
+    glm::ivec2 regionMax = glm::clamp(max, glm::ivec2(0), mSize - glm::ivec2(1));
+    
+    std::set<int> removed;
+    for (int y = regionMin.y; y <= regionMax.y; ++y)
+    {
+        for (int x = regionMin.x; x <= regionMax.x; ++x)
+        {
+            const int owner = mOwners[x + y * mSize.x];
+            if (owner >= 0)
+                removed.insert(owner);
+        }
+    }
+    
+    for (int id : removed)
+    {
+        regionMin = glm::min(regionMin, mRectangles[id].min);
+        regionMax = glm::max(regionMax, mRectangles[id].max);
+        removeRectangle(id);
+    }
+    
+    for (int id : decompose(grid, regionMin, regionMax))
+        connect(id);
+}
+
+std::vector<int> RectangleGraph::findRectanglePath(int start, int end) const
+{
+    const int startRectangle = getRectangle(start);
+    const int endRectangle = getRectangle(end);
+    if (startRectangle < 0 || endRectangle < 0)
+    {
+        debug::log("Failed to find path between the two points", debug::severity::Minor);
+        return { };
+    }
+    
+    const glm::ivec2 endPos(end % mSize.x, end / mSize.x);
+    
+    // The cost of crossing a rectangle depends on where it was entered, so the entry cell is tracked
+    // alongside the gScore. The entry cell is the closest cell in each portal to where the walk currently is.
+    std::unordered_map<int, int> cameFrom;
+    std::unordered_map<int, float> gScore { { startRectangle, 0.f } };
+    std::unordered_map<int, glm::ivec2> entryPos { { startRectangle, glm::ivec2(start % mSize.x, start / mSize.x) } };
+    
+    std::priority_queue<FNode<int>> pFScore;
+    pFScore.push({ startRectangle, static_cast<float>(diagonalDistance(entryPos[startRectangle], endPos)) });
+    
+    while (!pFScore.empty())
+    {
+        const FNode<int> current = pFScore.top();
+        pFScore.pop();
+        
+        const float currentScore = gScore[current.node];
+        const glm::ivec2 currentPos = entryPos[current.node];
+        if (current.fScore > currentScore + static_cast<float>(diagonalDistance(currentPos, endPos)))
+            continue;  // A better route has been found since this was queued.
+        
+        if (current.node == endRectangle)
+            return reconstructPath(cameFrom, current.node);
+        
+        for (const Portal &portal : mPortals[current.node])
+        {
+            const glm::ivec2 exit = glm::clamp(currentPos, portal.fromMin, portal.fromMax);
+            const glm::ivec2 entry = glm::clamp(exit, portal.toMin, portal.toMax);
+            const float adjacentScore = currentScore + static_cast<float>(diagonalDistance(currentPos, exit) + 1);
+            
+            auto it = gScore.find(portal.to);
+            if (it != gScore.end() && it->second <= adjacentScore)
+                continue;
+            
+            cameFrom[portal.to] = current.node;
+            gScore[portal.to] = adjacentScore;
+            entryPos[portal.to] = entry;
+            pFScore.push({ portal.to, adjacentScore + static_cast<float>(diagonalDistance(entry, endPos)) });
+        }
+    }
+    
+    debug::log("Failed to find path between the two points", debug::severity::Minor);
+    return { };
+}
+
+std::vector<int> RectangleGraph::refinePath(const std::vector<int> &rectanglePath, int start, int end) const
+{
+    if (rectanglePath.empty())
+        return { };
+    
+    std::vector<int> path { start };
+    glm::ivec2 currentPos(start % mSize.x, start / mSize.x);
+    
+    for (int i = 0; i + 1 < static_cast<int>(rectanglePath.size()); ++i)
+    {
+        const auto &portals = mPortals[rectanglePath[i]];
+        const auto portal = std::find_if(portals.begin(), portals.end(), [&](const Portal &p) {
+            return p.to == rectanglePath[i + 1];
+        });
+        
+        const glm::ivec2 exit = glm::clamp(currentPos, portal->fromMin, portal->fromMax);
+        walk(currentPos, exit, mSize.x, path);
+        
+        currentPos = glm::clamp(exit, portal->toMin, portal->toMax);
+        path.push_back(currentPos.x + currentPos.y * mSize.x);
+    }
+    
+    walk(currentPos, glm::ivec2(end % mSize.x, end / mSize.x), mSize.x, path);
+    return path;
+}
+
+std::vector<int> RectangleGraph::findPath(int start, int end) const
+{
+    return refinePath(findRectanglePath(start, end), start, end);
+}
+
+int RectangleGraph::getRectangle(int cell) const
+{
+    if (cell < 0 || cell >= static_cast<int>(mOwners.size()))
+        return -1;
+    return mOwners[cell];
+}
+
+const std::vector<RectangleGraph::Rectangle> &RectangleGraph::getRectangles() const
+{
+    return mRectangles;
+}
+
+RectangleGraph::Stats RectangleGraph::getStats() const
+{
+    Stats stats;
+    stats.cellCount = mOwners.size();
+    stats.nodeCount = mRectangles.size() - mFreeIds.size();
+    stats.memoryBytes = mOwners.capacity() * sizeof(int)
+                      + mRectangles.capacity() * sizeof(Rectangle)
+                      + mPortals.capacity() * sizeof(std::vector<Portal>)
+                      + mFreeIds.capacity() * sizeof(int);
+    
+    for (const auto &portals : mPortals)
+    {
+        stats.portalCount += portals.size();
+        stats.memoryBytes += portals.capacity() * sizeof(Portal);
+    }
+    
+    return stats;
+}
+
+std::vector<int> RectangleGraph::decompose(const Grid &grid, const glm::ivec2 &min, const glm::ivec2 &max)
+{
+    const auto isAvailable = [&](int x, int y) {
+        const int cell = x + y * mSize.x;
+        return mOwners[cell] < 0 && grid.verifyCell(cell);
+    };
+    
+    std::vector<int> created;
+    for (int y = min.y; y <= max.y; ++y)
+    {
+        for (int x = min.x; x <= max.x; ++x)
+        {
+            if (!isAvailable(x, y))
+                continue;
+            
+            Rectangle rectangle { { x, y }, { x, y }, true };
+            while (rectangle.max.x + 1 < mSize.x && isAvailable(rectangle.max.x + 1, y))
+                rectangle.max.x++;
+            
+            bool canGrow = true;
+            while (canGrow && rectangle.max.y + 1 < mSize.y)
+            {
+                for (int i = rectangle.min.x; i <= rectangle.max.x && canGrow; ++i)
+                    canGrow = isAvailable(i, rectangle.max.y + 1);
+                if (canGrow)
+                    rectangle.max.y++;
+            }
+            
+            int id;
+            if (mFreeIds.empty())
+            {
+                id = static_cast<int>(mRectangles.size());
+                mRectangles.push_back(rectangle);
+                mPortals.emplace_back();
+            }
+            else
+            {
+                id = mFreeIds.back();
+                mFreeIds.pop_back();
+                mRectangles[id] = rectangle;
+            }
+            
+            for (int j = rectangle.min.y; j <= rectangle.max.y; ++j)
+            {
+                for (int i = rectangle.min.x; i <= rectangle.max.x; ++i)
+                    mOwners[i + j * mSize.x] = id;
+            }
+            
+            created.push_back(id);
+        }
+    }
+    
+    return created;
+}
+
+void RectangleGraph::connect(int id)
+{
+    const Rectangle &rectangle = mRectangles[id];
+    
+    // Every rectangle that touches this one has a cell in the ring around it.
+    std::set<int> neighbours;
+    for (int y = rectangle.min.y - 1; y <= rectangle.max.y + 1; ++y)
+    {
+        const bool isEdgeRow = y == rectangle.min.y - 1 || y == rectangle.max.y + 1;
+        const int step = isEdgeRow ? 1 : rectangle.max.x - rectangle.min.x + 2;
+        for (int x = rectangle.min.x - 1; x <= rectangle.max.x + 1; x += step)
+        {
+            if (!isInBounds({ x, y }))
+                continue;
+            const int owner = mOwners[x + y * mSize.x];
+            if (owner >= 0)
+                neighbours.insert(owner);
+        }
+    }
+    
+    for (int neighbour : neighbours)
+    {
+        auto &portals = mPortals[id];
+        const bool isConnected = std::any_of(portals.begin(), portals.end(), [neighbour](const Portal &p) {
+            return p.to == neighbour;
+        });
+        if (isConnected)
+            continue;
+        
+        // The cells in each rectangle that touch the other one are the overlap with the other grown by one.
+        const Rectangle &other = mRectangles[neighbour];
+        const glm::ivec2 fromMin = glm::max(rectangle.min, other.min - glm::ivec2(1));
+        const glm::ivec2 fromMax = glm::min(rectangle.max, other.max + glm::ivec2(1));
+        const glm::ivec2 toMin   = glm::max(other.min, rectangle.min - glm::ivec2(1));
+        const glm::ivec2 toMax   = glm::min(other.max, rectangle.max + glm::ivec2(1));
+        
+        portals.push_back({ neighbour, fromMin, fromMax, toMin, toMax });
+        mPortals[neighbour].push_back({ id, toMin, toMax, fromMin, fromMax });
+    }
+}
+
+void RectangleGraph::removeRectangle(int id)
+{
+    for (const Portal &portal : mPortals[id])
+    {
+        auto &otherPortals = mPortals[portal.to];
+        otherPortals.erase(std::remove_if(otherPortals.begin(), otherPortals.end(), [id](const Portal &p) {
+            return p.to == id;
+        }), otherPortals.end());
+    }
+    mPortals[id].clear();
+    
+    Rectangle &rectangle = mRectangles[id];
+    for (int y = rectangle.min.y; y <= rectangle.max.y; ++y)
+    {
+        for (int x = rectangle.min.x; x <= rectangle.max.x; ++x)
+            mOwners[x + y * mSize.x] = -1;
+    }
+    
+    rectangle.isAlive = false;
+    mFreeIds.push_back(id);
+}
+
+bool RectangleGraph::isInBounds(const glm::ivec2 &pos) const
+{
+    return pos.x >= 0 && pos.y >= 0 && pos.x < mSize.x && pos.y < mSize.y;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file SearchContext.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "SearchContext.h"
+
+#include "Grid.h"
+#include "ClearanceMap.h"
+#include "Common.h"
+
+SearchContext::SearchContext(size_t cellCount)
+{
+    reserve(cellCount);
+    mOpenSet.reserve(cellCount);
+    mPath.reserve(cellCount);
+}
+
+const std::vector<int> &SearchContext::findPath(const Grid &grid, int start, int end)
+{
+    // The move masks already filter out the walls.
+    return search(grid, start, end, [](int) { return true; });
+}
+
+const std::vector<int> &SearchContext::findPath(
+        const Grid &grid, const ClearanceMap &clearance, int radius, int start, int end)
+{
+    if (!clearance.canFit(start, radius))
+    {
+        reset();
+        debug::log("The agent does not fit at the start of the path", debug::severity::Minor);
+        return mPath;
+    }
+    return search(grid, start, end, [&clearance, radius](int cell) { return clearance.canFit(cell, radius); });
+}
+
+template<typename Passable>
+const std::vector<int> &SearchContext::search(const Grid &grid, int start, int end, const Passable &isPassable)
+{
+    reset();
+    reserve(grid.getCellCount());
+    mStats.queries++;
+    
+    const auto heuristic = [&grid, end](int cell) {
+        return static_cast<float>(grid.getDiagonalDistance(cell, end));
+    };
+    
+    mGScore[start] = 0.f;
+    mCameFrom[start] = -1;
+    mGeneration[start] = mCurrentGeneration;
+    pushBack(mOpenSet, { start, heuristic(start) });
+    
+    while (!mOpenSet.empty())
+    {
+        std::pop_heap(mOpenSet.begin(), mOpenSet.end());
+        const FNode<int> current = mOpenSet.back();
+        mOpenSet.pop_back();
+        
+        const float currentScore = mGScore[current.node];
+        if (current.fScore > currentScore + heuristic(current.node))
+            continue;  // A better route to this cell has been found since it was queued.
+        
+        mStats.expanded++;
+        
+        if (current.node == end)
+        {
+            // The path is traced backwards, so flip it in place.
+            for (int cell = end; cell >= 0; cell = mCameFrom[cell])
+                pushBack(mPath, cell);
+            std::reverse(mPath.begin(), mPath.end());
+            return mPath;
+        }
+        
+        uint32_t moves = grid.getMoveMask(current.node);
+        for (; moves != 0; moves &= moves - 1)
+        {
+            const int adjacent = grid.getNeighbour(current.node, countTrailingZeros(moves));
+            if (!isPassable(adjacent))
+                continue;
+            
+            const float adjacentScore = currentScore + 1.f;  // All grid cells are equidistant.
+            
+            if (mGeneration[adjacent] == mCurrentGeneration && mGScore[adjacent] <= adjacentScore)
+                continue;
+            
+            mGeneration[adjacent] = mCurrentGeneration;
+            mGScore[adjacent] = adjacentScore;
+            mCameFrom[adjacent] = current.node;
+            pushBack(mOpenSet, { adjacent, adjacentScore + heuristic(adjacent) });
+            std::push_heap(mOpenSet.begin(), mOpenSet.end());
+        }
+    }
+    
+    debug::log("Failed to find path between the two points", debug::severity::Minor);
+    return mPath;
+}
+
+void SearchContext::reset()
+{
+    mOpenSet.clear();
+    mPath.clear();
+    
+    if (++mCurrentGeneration == 0)
+    {
+        // Wrapped around, so old stamps could match again.
+        std::fill(mGeneration.begin(), mGeneration.end(), 0u);
+        mCurrentGeneration = 1;
+    }
+}
+
+const std::vector<int> &SearchContext::getPath() const
+{
+    return mPath;
+}
+
+const SearchContext::Stats &SearchContext::getStats() const
+{
+    return mStats;
+}
+
+void SearchContext::reserve(size_t cellCount)
+{
+    if (mGeneration.size() >= cellCount)
+        return;
+    
+    mStats.allocations += 3;
+    mGScore.resize(cellCount);
+    mCameFrom.resize(cellCount);
+    mGeneration.resize(cellCount, 0u);
+}
@@ -11,69 +11,61 @@
 
 #include <imgui.h>
 #include <fstream>
-#include <sstream>
 
 
-Agent::Agent()
-{
-    // Creates a Q-Table for every possible state the Agent can be in.
-    
-    const std::array<std::string, 9> distanceOrdering {
-        "00", "01", "02", "10", "11", "12", "20", "21", "22"
-    };
-    
-    const std::array<std::string, 4> dirs { "1", "2", "3", "4" };
-    
-    // Create every single combination of directions.
-    for (const auto &north : dirs)
-    {
-        for (const auto &east : dirs)
-        {
-            for (const auto &south : dirs)
-            {
-                for (const auto &west : dirs)
-                {
-                    for (const auto &distanceTuple : distanceOrdering)
-                    {
-                        std::stringstream ss;
-                        ss << distanceTuple << north << east << south << west;
-                        mQTable.insert( { ss.str(), { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f } } );
-                    }
-                }
-            }
-        }
-    }
-}
-
-glm::ivec2 Agent::performAction(const State &state)
+glm::ivec2 Agent::performAction(State state)
 {
     mAction    = exploit(state);
-    mPosition += mActionTable.at(mAction);
+    mPosition += getActionOffset(mAction);
     
     return mPosition;
 }
 
-glm::ivec2 Agent::performTrainingAction(const State &state)
+glm::ivec2 Agent::performTrainingAction(State state)
 {
     mAction    = chooseAction(state);
-    mPosition += mActionTable.at(mAction);
+    mPosition += getActionOffset(mAction);
     
     return mPosition;
 }
 
 void Agent::undoAction()
 {
-    mPosition -= mActionTable.at(mAction);
+    mPosition -= getActionOffset(mAction);
+}
+
+void Agent::reward(float points, State currState, State nextState)
+{
+    if (lambda > 0.f)
+    {
+        mChanges.add(mTraces.update(mQTable, currState, mAction, points, nextState, alpha, gamma, lambda));
+    }
+    else
+    {
+        int actionIndex = static_cast<int>(mAction);
+        float &bucket   = mQTable[currState][actionIndex];
+        float maxOfQ    = getMaxInNextState(nextState);
+        const float previous = bucket;
+        
+        // Bellman's Equation.
+        bucket = (1 - alpha) * bucket + alpha * (points + gamma * maxOfQ);
+        mChanges.add(glm::abs(bucket - previous));
+    }
+    
+    if (mReplay.isEnabled())
+    {
+        mReplay.add(currState, mAction, points, nextState);
+        mChanges.add(mReplay.step(mQTable, alpha, gamma));
+    }
 }
 
-void Agent::reward(float points, const State &currState, const State &nextState)
+void Agent::plan(float points, State currState, State nextState)
 {
-    int actionIndex = static_cast<int>(mAction);
-    float &bucket   = mQTable.at(currState)[actionIndex];
-    float maxOfQ    = getMaxInNextState(nextState);
+    if (mPlanningSteps <= 0)
+        return;
     
-    // Bellman's Equation.
-    bucket = (1 - alpha) * bucket + alpha * (points + gamma * maxOfQ);
+    mModel.observe(currState, mAction, points, nextState);
+    mChanges.add(mModel.plan(mQTable, mPlanningSteps, alpha, gamma));
 }
 
 void Agent::renderOptions()
@@ -83,6 +75,22 @@ void Agent::renderOptions()
     ImGui::DragFloat("Minimum Exploration Rate", &mMinExplorationRate);
     ImGui::DragFloat("Learning Rate", &alpha, 0.01f);
     ImGui::DragFloat("Discount Factor", &gamma, 0.01f);
+    ImGui::SliderFloat("Trace Decay (Lambda)", &lambda, 0.f, 1.f);
+    ImGui::DragInt("Planning Steps (Dyna-Q)", &mPlanningSteps, 1.f, 0, 1000);
+    ImGui::Text("Model Pairs Seen: %zu", mModel.getSeenCount());
+    
+    ReplayBuffer::Settings settings = mReplay.getSettings();
+    bool isPrioritised = settings.samplingMode == ReplayBuffer::sampling::Prioritised;
+    bool hasChanged = ImGui::DragScalar("Replay Capacity", ImGuiDataType_U32, &settings.capacity, 100.f);
+    hasChanged |= ImGui::DragScalar("Replay Batch Size", ImGuiDataType_U32, &settings.batchSize, 1.f);
+    hasChanged |= ImGui::DragScalar("Steps Between Replays", ImGuiDataType_U32, &settings.replayInterval, 1.f);
+    hasChanged |= ImGui::Checkbox("Prioritised Replay", &isPrioritised);
+    if (hasChanged)
+    {
+        settings.samplingMode = isPrioritised ? ReplayBuffer::sampling::Prioritised : ReplayBuffer::sampling::Uniform;
+        setReplaySettings(settings);
+    }
+    ImGui::Text("Replay Memory: %.1f KB", static_cast<float>(mReplay.getMemoryUsage()) / 1024.f);
 }
 
 void Agent::serialize(std::ofstream &outStream) const
@@ -90,13 +98,14 @@ void Agent::serialize(std::ofstream &outStream) const
     outStream   << "#xr " << mExplorationRate     << "\n"
                 << "#xm " << mMinExplorationRate  << "\n"
                 << "#al " << alpha                << "\n"
-                << "#ga " << gamma                << "\n";
+                << "#ga " << gamma                << "\n"
+                << "#la " << lambda               << "\n";
     
     outStream << "\n";
-    for (const auto &[key, value] : mQTable)
+    for (State state = 0; state < stateCount; ++state)
     {
-        outStream << "#qt " << key << ' ';
-        for (const auto &item : value)
+        outStream << "#qt " << stateToString(state) << ' ';
+        for (const auto &item : mQTable[state])
         {
             outStream << item << ' ';
         }
@@ -111,7 +120,11 @@ void Agent::load(const fileSystem::aiSymbols &data)
     mMinExplorationRate = data.explorationRateMin;
     alpha               = data.alpha;
     gamma               = data.gamma;
+    lambda              = data.lambda;
     mQTable             = data.qTable;
+    mReplay.clear();
+    mTraces.clear();
+    mModel.clear();
 }
 
 void Agent::setExplorationRate(float rate)
@@ -134,16 +147,111 @@ const glm::ivec2 &Agent::getPosition() const
     return mPosition;
 }
 
-action Agent::chooseAction(const State &state) const
+glm::ivec2 Agent::getPreviousPosition() const
+{
+    return mPosition - getActionOffset(mAction);
+}
+
+action Agent::getAction() const
+{
+    return mAction;
+}
+
+const QTable &Agent::getQTable() const
+{
+    return mQTable;
+}
+
+void Agent::setQTable(const QTable &qTable)
+{
+    mQTable = qTable;
+}
+
+float Agent::getLearningRate() const
+{
+    return alpha;
+}
+
+float Agent::getDiscountFactor() const
+{
+    return gamma;
+}
+
+float Agent::getMinExplorationRate() const
+{
+    return mMinExplorationRate;
+}
+
+const QChanges &Agent::getChanges() const
+{
+    return mChanges;
+}
+
+void Agent::resetChanges()
+{
+    mChanges = QChanges();
+}
+
+float Agent::getTraceDecay() const
+{
+    return lambda;
+}
+
+void Agent::setTraceDecay(float traceDecay)
+{
+    lambda = glm::clamp(traceDecay, 0.f, 1.f);
+}
+
+void Agent::clearTraces()
+{
+    mTraces.clear();
+}
+
+void Agent::setReplaySettings(const ReplayBuffer::Settings &settings)
+{
+    mReplay = ReplayBuffer(settings);
+}
+
+const ReplayBuffer &Agent::getReplayBuffer() const
+{
+    return mReplay;
+}
+
+void Agent::clearReplay()
+{
+    mReplay.clear();
+}
+
+int Agent::getPlanningSteps() const
+{
+    return mPlanningSteps;
+}
+
+void Agent::setPlanningSteps(int steps)
+{
+    mPlanningSteps = glm::max(steps, 0);
+}
+
+const DynaModel &Agent::getModel() const
+{
+    return mModel;
+}
+
+void Agent::clearModel()
+{
+    mModel.clear();
+}
+
+action Agent::chooseAction(State state) const
 {
     if (randomFloat() < mExplorationRate)
         return explore();
     return exploit(state);
 }
 
-action Agent::exploit(const State &state) const
+action Agent::exploit(State state) const
 {
-    const auto &currentState = mQTable.at(state);
+    const auto &currentState = mQTable[state];
     const uint32_t indexOfLargestValue = std::distance(
             currentState.begin(),
             std::max_element(currentState.begin(), currentState.end())
@@ -156,9 +264,9 @@ action Agent::explore()
     return static_cast<action>(randomInt(0u, static_cast<uint32_t>(action::Count) - 1));
 }
 
-float Agent::getMaxInNextState(const State &nextState)
+float Agent::getMaxInNextState(State nextState)
 {
-    const auto &values = mQTable.at(nextState);
+    const auto &values = mQTable[nextState];
     const auto maxIndex = std::distance(values.begin(), std::max_element(values.begin(), values.end()));
     return values[maxIndex];
 }
@@ -0,0 +1,184 @@
+/**
+ * @file BatchEnvironment.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "BatchEnvironment.h"
+
+#include "Grid.h"
+
+#include <chrono>
+
+namespace
+{
+    constexpr int actionCount = static_cast<int>(action::Count);
+}
+
+BatchEnvironment::BatchEnvironment(std::shared_ptr<Grid> grid, const Rewards &rewards, int agentCount, uint64_t seed)
+    : mGrid(std::move(grid)), mRewards(rewards), mAgentCount(agentCount), mWidth(mGrid->getSize().x),
+      mRandom(seed),
+      mCells(agentCount), mX(agentCount), mY(agentCount), mGoalX(agentCount), mGoalY(agentCount),
+      mLastDistances(agentCount), mStates(agentCount), mNextStates(agentCount), mActions(agentCount),
+      mCanMove(agentCount), mRewardValues(agentCount), mIsAtGoal(agentCount), mIterations(agentCount)
+{
+    // Same ranks as Environment::getWallDistances(), calculated once per cell.
+    mWallRanks.resize(mGrid->getCellCount());
+    for (int cell = 0; cell < mGrid->getCellCount(); ++cell)
+    {
+        const Grid::WallDistances &wallDistances = mGrid->getDistanceToOrthogonalWalls(cell);
+        int nesw = 0;
+        for (int i = 0; i < 4; ++i)
+            nesw = (nesw << 2) | (glm::clamp(static_cast<int>(wallDistances[i]), 1, wallRankCount) - 1);
+        mWallRanks[cell] = static_cast<uint8_t>(nesw);
+    }
+    
+    resetAll();
+}
+
+void BatchEnvironment::resetAll()
+{
+    for (int agent = 0; agent < mAgentCount; ++agent)
+        resetAgent(agent);
+}
+
+void BatchEnvironment::chooseActions(const QTable &qTable, float explorationRate)
+{
+    // 64 bits so that a rate of 1 becomes 2^32, which every 32-bit random number is below.
+    const auto threshold = static_cast<uint64_t>(static_cast<double>(glm::clamp(explorationRate, 0.f, 1.f))
+                                                 * 4294967296.0);
+    for (int agent = 0; agent < mAgentCount; ++agent)
+    {
+        const ActionValues &values = qTable[mStates[agent]];
+        int best = 0;
+        for (int i = 1; i < actionCount; ++i)
+            best = values[i] > values[best] ? i : best;
+        
+        const uint32_t random = mRandom();
+        mActions[agent] = static_cast<uint8_t>(random < threshold ? (random >> 8) % actionCount : best);
+    }
+}
+
+void BatchEnvironment::step()
+{
+    const Grid &grid = *mGrid;
+    
+    // Apply the actions. Moves into walls leave the agent where it is.
+    for (int agent = 0; agent < mAgentCount; ++agent)
+    {
+        const int move = mActions[agent];
+        const int canMove = grid.canMove(mCells[agent], move);
+        const int dx = actionOffsets[move][0] * canMove;
+        const int dy = actionOffsets[move][1] * canMove;
+        mX[agent] += dx;
+        mY[agent] += dy;
+        mCells[agent] += dx + dy * mWidth;
+        mCanMove[agent] = static_cast<uint8_t>(canMove);
+        mIsAtGoal[agent] = static_cast<uint8_t>(mX[agent] == mGoalX[agent] && mY[agent] == mGoalY[agent]);
+    }
+    
+    // Rewards. Agents that walked into a wall didn't get any closer, so they get awayFromGoal here and intoWall in
+    // applyUpdates().
+    for (int agent = 0; agent < mAgentCount; ++agent)
+    {
+        const int dx = mGoalX[agent] - mX[agent];
+        const int dy = mGoalY[agent] - mY[agent];
+        const int distance = dx * dx + dy * dy;
+        const float moveReward = distance < mLastDistances[agent] ? mRewards.towardsGoal : mRewards.awayFromGoal;
+        mRewardValues[agent] = mIsAtGoal[agent] ? mRewards.goal : moveReward;
+        mLastDistances[agent] = distance;
+        ++mIterations[agent];
+    }
+    
+    // Sensors. The goal direction is X * 3 + Y where 1 is left/up and 2 is right/down.
+    for (int agent = 0; agent < mAgentCount; ++agent)
+    {
+        const int xDir = (mX[agent] > mGoalX[agent]) + 2 * (mX[agent] < mGoalX[agent]);
+        const int yDir = (mY[agent] > mGoalY[agent]) + 2 * (mY[agent] < mGoalY[agent]);
+        mNextStates[agent] = encodeState(xDir * 3 + yDir, mWallRanks[mCells[agent]]);
+    }
+}
+
+void BatchEnvironment::applyUpdates(QTable &qTable, float alpha, float gamma) const
+{
+    auto maxOf = [](const ActionValues &values) {
+        float maxOfQ = values[0];
+        for (int i = 1; i < actionCount; ++i)
+            maxOfQ = std::max(maxOfQ, values[i]);
+        return maxOfQ;
+    };
+    
+    for (int agent = 0; agent < mAgentCount; ++agent)
+    {
+        const ActionValues &next = qTable[mNextStates[agent]];
+        float &bucket = qTable[mStates[agent]][mActions[agent]];
+        
+        // Bellman's Equation. Walking into a wall is updated with intoWall first, like Environment::undoAgent().
+        if (!mCanMove[agent])
+            bucket = (1 - alpha) * bucket + alpha * (mRewards.intoWall + gamma * maxOf(next));
+        bucket = (1 - alpha) * bucket + alpha * (mRewardValues[agent] + gamma * maxOf(next));
+    }
+}
+
+void BatchEnvironment::restartFinished(uint64_t iterationMax, BatchEnvironment::Stats &stats)
+{
+    stats.steps += mAgentCount;
+    for (int agent = 0; agent < mAgentCount; ++agent)
+    {
+        mStates[agent] = mNextStates[agent];
+        if (mIsAtGoal[agent] || mIterations[agent] > iterationMax)
+        {
+            ++stats.episodes;
+            stats.successes += mIsAtGoal[agent];
+            resetAgent(agent);
+        }
+    }
+}
+
+BatchEnvironment::Stats BatchEnvironment::train(QTable &qTable, const BatchEnvironment::Settings &settings)
+{
+    Stats stats;
+    const auto startTime = std::chrono::steady_clock::now();
+    while (stats.episodes < settings.episodes)
+    {
+        const float percentage = static_cast<float>(stats.episodes) / static_cast<float>(settings.episodes);
+        const float explorationRate = glm::max(settings.minExplorationRate, glm::smoothstep(1.f, 0.f, percentage));
+        
+        chooseActions(qTable, explorationRate);
+        step();
+        applyUpdates(qTable, settings.alpha, settings.gamma);
+        restartFinished(settings.iterationMax, stats);
+    }
+    const auto endTime = std::chrono::steady_clock::now();
+    
+    stats.seconds = std::chrono::duration<double>(endTime - startTime).count();
+    stats.stepsPerSecond = stats.seconds > 0.0 ? static_cast<double>(stats.steps) / stats.seconds : 0.0;
+    return stats;
+}
+
+int BatchEnvironment::getAgentCount() const
+{
+    return mAgentCount;
+}
+
+void BatchEnvironment::resetAgent(int agent)
+{
+    const FreeCellIndex &freeCells = mGrid->getFreeCells();
+    const glm::ivec2 start = mGrid->indexToVector(freeCells.sample(mRandom));
+    const glm::ivec2 goal  = mGrid->indexToVector(freeCells.sample(mRandom));
+    
+    mCells[agent] = mGrid->vectorToIndex(start);
+    mX[agent] = start.x;
+    mY[agent] = start.y;
+    mGoalX[agent] = goal.x;
+    mGoalY[agent] = goal.y;
+    const glm::ivec2 toGoal = goal - start;
+    mLastDistances[agent] = toGoal.x * toGoal.x + toGoal.y * toGoal.y;
+    mIterations[agent] = 0;
+    mIsAtGoal[agent] = 0;
+    
+    const int xDir = (start.x > goal.x) + 2 * (start.x < goal.x);
+    const int yDir = (start.y > goal.y) + 2 * (start.y < goal.y);
+    mStates[agent] = encodeState(xDir * 3 + yDir, mWallRanks[mCells[agent]]);
+}
@@ -0,0 +1,202 @@
+/**
+ * @file ConvergenceTracker.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "ConvergenceTracker.h"
+
+#include "Grid.h"
+#include "Random.h"
+
+void ConvergenceTracker::reset(const Grid &grid, const ConvergenceTracker::Settings &settings)
+{
+    mSettings = settings;
+    mStats = Stats();
+    mEvaluationPairs = makeEvaluationPairs(grid, mSettings.evaluationCount, evaluationSeed);
+    mWindow.assign(glm::max<uint64_t>(mSettings.successWindow, 1), false);
+    mWindowNext = 0;
+    mWindowCount = 0;
+    mWindowSuccesses = 0;
+    mCalmEpisodes = 0;
+    mEvaluationsSinceBest = 0;
+}
+
+void ConvergenceTracker::endEpisode(bool isSuccess, const QChanges &changes, const QTable &qTable,
+                                    Environment &environment, uint64_t iterationMax)
+{
+    ++mStats.episodes;
+    
+    mStats.lastMaxDelta  = changes.maxDelta;
+    mStats.lastMeanDelta = changes.updates > 0 ? static_cast<float>(changes.deltaSum / changes.updates) : 0.f;
+    mCalmEpisodes = mStats.lastMaxDelta < mSettings.deltaThreshold ? mCalmEpisodes + 1 : 0;
+    
+    mWindowSuccesses += static_cast<uint64_t>(isSuccess) - static_cast<uint64_t>(mWindow[mWindowNext]);
+    mWindow[mWindowNext] = isSuccess;
+    mWindowNext = (mWindowNext + 1) % mWindow.size();
+    mWindowCount = glm::min<uint64_t>(mWindowCount + 1, mWindow.size());
+    mStats.windowSuccessRate = static_cast<float>(mWindowSuccesses) / static_cast<float>(mWindowCount);
+    
+    const bool isEvaluationDue = mSettings.evaluationInterval > 0 && !mEvaluationPairs.empty()
+                                 && mStats.episodes % mSettings.evaluationInterval == 0;
+    if (isEvaluationDue)
+    {
+        mStats.lastEvaluation = evaluate(qTable, environment, mEvaluationPairs, iterationMax);
+        if (mStats.evaluations++ == 0 || mStats.lastEvaluation.successRate > mStats.bestEvaluation.successRate)
+        {
+            mStats.bestEvaluation = mStats.lastEvaluation;
+            mEvaluationsSinceBest = 0;
+        }
+        else
+        {
+            ++mEvaluationsSinceBest;
+        }
+    }
+    
+    if (mSettings.isEnabled && mStats.reason == stopReason::None)
+        mStats.reason = checkStop();
+}
+
+void ConvergenceTracker::finish()
+{
+    if (mStats.reason == stopReason::None)
+        mStats.reason = stopReason::EpisodeLimit;
+}
+
+bool ConvergenceTracker::shouldStop() const
+{
+    return mStats.reason != stopReason::None;
+}
+
+const ConvergenceTracker::Stats &ConvergenceTracker::getStats() const
+{
+    return mStats;
+}
+
+const ConvergenceTracker::Settings &ConvergenceTracker::getSettings() const
+{
+    return mSettings;
+}
+
+void ConvergenceTracker::setSettings(const ConvergenceTracker::Settings &settings)
+{
+    mSettings = settings;
+    const uint64_t windowSize = glm::max<uint64_t>(mSettings.successWindow, 1);
+    if (windowSize == mWindow.size())
+        return;
+    
+    // Copy the latest results that fit, oldest first.
+    std::vector<bool> window(windowSize, false);
+    const uint64_t kept = glm::min(mWindowCount, windowSize);
+    mWindowSuccesses = 0;
+    for (uint64_t i = 0; i < kept; ++i)
+    {
+        window[i] = mWindow[(mWindowNext + mWindow.size() - kept + i) % mWindow.size()];
+        mWindowSuccesses += window[i];
+    }
+    
+    mWindow = std::move(window);
+    mWindowNext = kept % windowSize;
+    mWindowCount = kept;
+}
+
+std::string_view ConvergenceTracker::toString(ConvergenceTracker::stopReason reason)
+{
+    switch (reason)
+    {
+        case stopReason::None:
+            return "Still training";
+        case stopReason::EpisodeLimit:
+            return "Reached the maximum number of episodes";
+        case stopReason::QConverged:
+            return "The Q-Table stopped changing";
+        case stopReason::SuccessWindow:
+            return "Enough recent episodes reached the goal";
+        case stopReason::EvaluationTarget:
+            return "The greedy policy reached its target on the fixed evaluation pairs";
+        case stopReason::EvaluationPlateau:
+            return "The greedy policy stopped improving on the fixed evaluation pairs";
+        default:
+            return "Unknown";
+    }
+}
+
+ConvergenceTracker::Pairs ConvergenceTracker::makeEvaluationPairs(const Grid &grid, int count, uint32_t seed)
+{
+    Pairs pairs;
+    const FreeCellIndex &freeCells = grid.getFreeCells();
+    if (freeCells.count() == 0)
+        return pairs;
+    
+    RandomStream rng(seed);
+    pairs.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const glm::ivec2 start = grid.indexToVector(freeCells.sample(rng));
+        const glm::ivec2 goal  = grid.indexToVector(freeCells.sample(rng));
+        pairs.emplace_back(start, goal);
+    }
+    return pairs;
+}
+
+ConvergenceTracker::Evaluation ConvergenceTracker::evaluate(const QTable &qTable, Environment &environment,
+                                                            const ConvergenceTracker::Pairs &pairs,
+                                                            uint64_t iterationMax)
+{
+    const Grid &grid = *environment.grid;
+    const glm::ivec2 trainingGoal = environment.goal;
+    
+    int successes = 0;
+    uint64_t successfulSteps = 0;
+    for (const auto &[start, goal] : pairs)
+    {
+        glm::ivec2 position = start;
+        environment.goal = goal;
+        for (uint64_t iteration = 0; iteration < iterationMax; ++iteration)
+        {
+            if (position == environment.goal)
+            {
+                ++successes;
+                successfulSteps += iteration;
+                break;
+            }
+            
+            const ActionValues &values = qTable[environment.generateState(position)];
+            const int move = static_cast<int>(std::max_element(values.begin(), values.end()) - values.begin());
+            if (grid.canMove(grid.vectorToIndex(position), move))
+                position += getActionOffset(static_cast<action>(move));
+        }
+    }
+    
+    environment.goal = trainingGoal;
+    
+    Evaluation evaluation;
+    if (!pairs.empty())
+        evaluation.successRate = static_cast<float>(successes) / static_cast<float>(pairs.size());
+    if (successes > 0)
+        evaluation.meanSteps = static_cast<float>(successfulSteps) / static_cast<float>(successes);
+    return evaluation;
+}
+
+ConvergenceTracker::stopReason ConvergenceTracker::checkStop() const
+{
+    if (mStats.episodes < mSettings.minEpisodes)
+        return stopReason::None;
+    
+    if (mSettings.deltaPatience > 0 && mCalmEpisodes >= mSettings.deltaPatience)
+        return stopReason::QConverged;
+    
+    if (mWindowCount >= mWindow.size() && mStats.windowSuccessRate >= mSettings.successThreshold)
+        return stopReason::SuccessWindow;
+    
+    if (mStats.evaluations > 0)
+    {
+        if (mStats.lastEvaluation.successRate >= mSettings.evaluationTarget)
+            return stopReason::EvaluationTarget;
+        if (mSettings.evaluationPatience > 0 && mEvaluationsSinceBest >= mSettings.evaluationPatience)
+            return stopReason::EvaluationPlateau;
+    }
+    
+    return stopReason::None;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file DynaModel.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "DynaModel.h"
+
+#include "Random.h"
+
+namespace
+{
+    constexpr int actionCount = static_cast<int>(action::Count);
+}
+
+DynaModel::DynaModel()
+    : mRewards(stateCount * actionCount, 0.f), mNextStates(stateCount * actionCount, unseen)
+{
+    mSeen.reserve(stateCount * actionCount);  // So that observing never allocates.
+}
+
+void DynaModel::observe(State state, action agentAction, float reward, State nextState)
+{
+    const auto pair = static_cast<uint16_t>(state * actionCount + static_cast<int>(agentAction));
+    if (mNextStates[pair] == unseen)
+        mSeen.push_back(pair);
+    mRewards[pair]    = reward;
+    mNextStates[pair] = nextState;
+}
+
+QChanges DynaModel::plan(QTable &qTable, int steps, float alpha, float gamma) const
+{
+    QChanges changes;
+    if (mSeen.empty())
+        return changes;
+    
+    RandomStream &rng = getRandomStream();
+    const auto seenCount = static_cast<uint32_t>(mSeen.size());
+    for (int i = 0; i < steps; ++i)
+    {
+        const uint16_t pair = mSeen[rng.nextBounded(seenCount)];
+        const ActionValues &next = qTable[mNextStates[pair]];
+        float maxOfQ = next[0];
+        for (int j = 1; j < actionCount; ++j)
+            maxOfQ = glm::max(maxOfQ, next[j]);
+        
+        // Bellman's Equation.
+        float &bucket = qTable[pair / actionCount][pair % actionCount];
+        const float previous = bucket;
+        bucket = (1 - alpha) * bucket + alpha * (mRewards[pair] + gamma * maxOfQ);
+        changes.add(glm::abs(bucket - previous));
+    }
+    return changes;
+}
+
+void DynaModel::clear()
+{
+    for (const uint16_t pair : mSeen)
+        mNextStates[pair] = unseen;
+    mSeen.clear();
+}
+
+size_t DynaModel::getSeenCount() const
+{
+    return mSeen.size();
+}
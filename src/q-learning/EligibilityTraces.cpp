@@ -0,0 +1,81 @@
+/**
+ * @file EligibilityTraces.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "EligibilityTraces.h"
+
+namespace
+{
+    constexpr int actionCount = static_cast<int>(action::Count);
+    
+    static_assert(stateCount * actionCount <= 0xFFFF, "State-action pairs no longer fit in the active list.");
+}
+
+EligibilityTraces::EligibilityTraces()
+    : mTraces(stateCount * actionCount, 0.f)
+{
+    mActive.reserve(256);  // Enough for a trace of gamma * lambda = 0.98, so updates don't allocate.
+}
+
+QChanges EligibilityTraces::update(QTable &qTable, State state, action agentAction, float points, State nextState,
+                               float alpha, float gamma, float lambda)
+{
+    const int actionIndex = static_cast<int>(agentAction);
+    const ActionValues &values = qTable[state];
+    const ActionValues &next   = qTable[nextState];
+    
+    float maxOfQ = next[0];
+    float maxOfCurrent = values[0];
+    for (int i = 1; i < actionCount; ++i)
+    {
+        maxOfQ       = glm::max(maxOfQ, next[i]);
+        maxOfCurrent = glm::max(maxOfCurrent, values[i]);
+    }
+    
+    // Watkins's cut: the steps before an exploratory action didn't lead here greedily, so they get no credit for it.
+    if (values[actionIndex] < maxOfCurrent)
+        clear();
+    
+    const float error = points + gamma * maxOfQ - values[actionIndex];
+    
+    // Replacing traces. Re-visiting a pair (e.g. walking into a wall) resets its trace rather than building it up.
+    const auto pair = static_cast<uint16_t>(state * actionCount + actionIndex);
+    if (mTraces[pair] == 0.f)
+        mActive.push_back(pair);
+    mTraces[pair] = 1.f;
+    
+    // Apply the error to every active pair and decay its trace, keeping the ones that are still above the threshold.
+    const float decay = gamma * lambda;
+    QChanges changes;
+    size_t kept = 0;
+    for (const uint16_t activePair : mActive)
+    {
+        float &trace = mTraces[activePair];
+        const float delta = alpha * error * trace;
+        qTable[activePair / actionCount][activePair % actionCount] += delta;
+        changes.add(glm::abs(delta));
+        
+        trace *= decay;
+        if (trace >= traceThreshold)
+            mActive[kept++] = activePair;
+        else
+            trace = 0.f;
+    }
+    mActive.resize(kept);
+    return changes;
+}
+
+void EligibilityTraces::clear()
+{
+    for (const uint16_t pair : mActive)
+        mTraces[pair] = 0.f;
+    mActive.clear();
+}
+
+size_t EligibilityTraces::getActiveCount() const
+{
+    return mActive.size();
+}
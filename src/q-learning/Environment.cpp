@@ -15,14 +15,15 @@
 
 State Environment::generateState(const glm::ivec2 &agentPosition)
 {
-    State newState  = getGoalDirection(agentPosition);
-    newState       += getWallDistances(agentPosition);
-    return newState;
+    updateWallRanks();
+    return encodeState(getGoalDirection(agentPosition), mWallRanks[grid->vectorToIndex(agentPosition)]);
 }
 
 bool Environment::verifyAgent(Agent &agent) const
 {
-    return grid->verifyCell(grid->vectorToIndex(agent.getPosition()));
+    // The move masks say which moves are legal from the cell the agent moved from.
+    const int previousCell = grid->vectorToIndex(agent.getPreviousPosition());
+    return grid->canMove(previousCell, static_cast<int>(agent.getAction()));
 }
 
 void Environment::undoAgent(Agent &agent) const
@@ -31,20 +32,34 @@ void Environment::undoAgent(Agent &agent) const
     agent.reward(mRewards.intoWall, state, state);
 }
 
-bool Environment::reward(Agent &agent, const State &nextState)
+bool Environment::reward(Agent &agent, State nextState, float &points)
 {
-    const glm::ivec2 &agentPosition = agent.getPosition();
-    if (agentPosition == goal)
-    {
-        agent.reward(mRewards.goal, state, nextState);
-        return true;
-    }
+    bool isAtGoal = false;
+    points = calculateReward(agent.getPosition(), isAtGoal);
+    agent.reward(points, state, nextState);
+    return isAtGoal;
+}
+
+float Environment::calculateReward(const glm::ivec2 &agentPosition, bool &isAtGoal)
+{
+    isAtGoal = agentPosition == goal;
+    if (isAtGoal)
+        return mRewards.goal;
     
     float currentDistanceToFinish = glm::distance(static_cast<glm::vec2>(agentPosition), static_cast<glm::vec2>(goal));
     bool isCloser = currentDistanceToFinish < mAgentsLastDistance;
     mAgentsLastDistance = currentDistanceToFinish;
-    agent.reward(isCloser ? mRewards.towardsGoal : mRewards.awayFromGoal, state, nextState);
-    return false;
+    return isCloser ? mRewards.towardsGoal : mRewards.awayFromGoal;
+}
+
+void Environment::resetDistance(const glm::ivec2 &agentPosition)
+{
+    mAgentsLastDistance = glm::distance(static_cast<glm::vec2>(agentPosition), static_cast<glm::vec2>(goal));
+}
+
+const Rewards &Environment::getRewards() const
+{
+    return mRewards;
 }
 
 void Environment::renderOptions()
@@ -73,38 +88,48 @@ void Environment::load(const fileSystem::aiSymbols &data)
     mRewards.intoWall     = data.rewardIntoWall;
 }
 
-std::string Environment::getGoalDirection(const glm::ivec2 &agentPosition) const
+int Environment::getGoalDirection(const glm::ivec2 &agentPosition) const
 {
     // Check which direction the goal is on the x-axis.
-    std::string xDir(1, static_cast<char>(direction::NoDirection));
+    direction xDir = direction::NoDirection;
     if (agentPosition.x < goal.x)
-        xDir = static_cast<char>(direction::Right);
+        xDir = direction::Right;
     else if (agentPosition.x > goal.x)
-        xDir = static_cast<char>(direction::Left);
+        xDir = direction::Left;
     
     // Check which direction the goal is on the y-axis.
-    std::string yDir(1, static_cast<char>(direction::NoDirection));
+    direction yDir = direction::NoDirection;
     if (agentPosition.y < goal.y)
-        yDir = static_cast<char>(direction::Down);
+        yDir = direction::Down;
     else if (agentPosition.y > goal.y)
-        yDir = static_cast<char>(direction::Up);
+        yDir = direction::Up;
     
-    return xDir + yDir;  // Concatenate the two to give us the first part of our state.
+    return static_cast<int>(xDir) * 3 + static_cast<int>(yDir);  // The first part of our state.
 }
 
-std::string Environment::getWallDistances(const glm::ivec2 &agentPosition) const
+int Environment::getWallDistances(const glm::ivec2 &agentPosition) const
 {
-    const std::vector<int> wallDistances = grid->getDistanceToOrthogonalWalls(grid->vectorToIndex(agentPosition));
-    
-    std::string nesw = "xxxx";  // North, East, South, West
-    const std::string_view ranks = "1234";
+    const Grid::WallDistances &wallDistances = grid->getDistanceToOrthogonalWalls(grid->vectorToIndex(agentPosition));
     
+    int nesw = 0;  // North, East, South, West
     for (int i = 0; i < 4; ++i)
     {
-        const int clampedDistance = glm::clamp(wallDistances[i], 0, 4);
-        nesw[i] = ranks[clampedDistance - 1];
+        const int clampedDistance = glm::clamp(static_cast<int>(wallDistances[i]), 1, wallRankCount);
+        nesw = (nesw << 2) | (clampedDistance - 1);
     }
     
     return nesw;
 }
 
+void Environment::updateWallRanks()
+{
+    const bool isSameGrid = !mWallRanksGrid.owner_before(grid) && !grid.owner_before(mWallRanksGrid);
+    if (isSameGrid && mWallRanksVersion == grid->getVersion())
+        return;
+    
+    mWallRanksGrid    = grid;
+    mWallRanksVersion = grid->getVersion();
+    mWallRanks.resize(grid->getCellCount());
+    for (int cell = 0; cell < grid->getCellCount(); ++cell)
+        mWallRanks[cell] = static_cast<uint8_t>(getWallDistances(grid->indexToVector(cell)));
+}
@@ -0,0 +1,177 @@
+/**
+ * @file PairScheduler.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "PairScheduler.h"
+
+#include "Grid.h"
+#include "Random.h"
+
+namespace
+{
+    constexpr int moveCount = 8;
+}
+
+void PairScheduler::reset(const Grid &grid, const PairScheduler::Settings &settings)
+{
+    mSettings = settings;
+    mSettings.bucketCount = glm::max(mSettings.bucketCount, 1);
+    mPairs.clear();
+    mBucketStarts.assign(mSettings.bucketCount + 1, 0);
+    mBucketWeights.assign(mSettings.bucketCount, 0.f);
+    mLastPair = 0;
+    mLastBucket = 0;
+    mUnlockedBucket = 0;
+    
+    const FreeCellIndex &freeCells = grid.getFreeCells();
+    if (!mSettings.isEnabled || freeCells.count() < 2)
+        return;
+    
+    const int startCount = glm::min(mSettings.startCount, freeCells.count());
+    std::vector<int> distances;
+    std::vector<int> cells;
+    for (int i = 0; i < startCount; ++i)
+    {
+        const int start = freeCells.select(static_cast<int>(static_cast<int64_t>(i) * freeCells.count() / startCount));
+        search(grid, start, distances, cells);
+        
+        // cells[0] is the start itself. The rest are sorted by distance, so even steps through them cover every
+        // distance from next door to the far side of the maze.
+        const int reachable = static_cast<int>(cells.size()) - 1;
+        const int goalCount = glm::min(mSettings.goalsPerStart, reachable);
+        for (int j = 0; j < goalCount; ++j)
+        {
+            const int goal = cells[1 + static_cast<int64_t>(j) * reachable / goalCount];
+            mPairs.push_back({ start, goal, distances[goal], 1.f });
+        }
+    }
+    
+    if (mPairs.empty())
+        return;
+    
+    std::sort(mPairs.begin(), mPairs.end(), [](const Pair &a, const Pair &b) { return a.distance < b.distance; });
+    
+    const int maxDistance = mPairs.back().distance;
+    const int bucketCount = mSettings.bucketCount;
+    for (const Pair &pair : mPairs)
+    {
+        const int bucket = glm::min(bucketCount - 1, (pair.distance - 1) * bucketCount / maxDistance);
+        ++mBucketStarts[bucket + 1];
+        mBucketWeights[bucket] += weightOf(pair);
+    }
+    for (int bucket = 0; bucket < bucketCount; ++bucket)
+        mBucketStarts[bucket + 1] += mBucketStarts[bucket];
+}
+
+const PairScheduler::Pair &PairScheduler::next(float progress)
+{
+    const auto bucketCount = static_cast<int>(mBucketWeights.size());
+    const float ramp = glm::max(mSettings.rampFraction, 0.0001f);
+    const float unlocked = glm::clamp(mSettings.initialFraction + (1.f - mSettings.initialFraction) * progress / ramp,
+                                      0.f, 1.f);
+    mUnlockedBucket = glm::clamp(static_cast<int>(std::ceil(unlocked * static_cast<float>(bucketCount))) - 1,
+                                 0, bucketCount - 1);
+    while (mUnlockedBucket < bucketCount - 1 && mBucketStarts[mUnlockedBucket + 1] == 0)
+        ++mUnlockedBucket;  // Short distances may not exist, so always unlock at least one group with pairs in it.
+    
+    RandomStream &rng = getRandomStream();
+    
+    float total = 0.f;
+    for (int bucket = 0; bucket <= mUnlockedBucket; ++bucket)
+        total += mBucketWeights[bucket];
+    
+    float target = rng.nextFloat() * total;
+    mLastBucket = 0;
+    while (mLastBucket < mUnlockedBucket && target >= mBucketWeights[mLastBucket])
+        target -= mBucketWeights[mLastBucket++];
+    while (mBucketStarts[mLastBucket + 1] == mBucketStarts[mLastBucket])
+        --mLastBucket;  // Rounding can walk off the end into an empty group.
+    
+    // Rejection sampling within the group. Weights are in [1, 1 + failureBoost], so few tries are needed.
+    const size_t first = mBucketStarts[mLastBucket];
+    const auto count = static_cast<uint32_t>(mBucketStarts[mLastBucket + 1] - first);
+    const float maxWeight = 1.f + mSettings.failureBoost;
+    do
+    {
+        mLastPair = first + rng.nextBounded(count);
+    } while (rng.nextFloat() * maxWeight >= weightOf(mPairs[mLastPair]));
+    
+    return mPairs[mLastPair];
+}
+
+void PairScheduler::report(bool isSuccess)
+{
+    if (mPairs.empty())
+        return;
+    
+    Pair &pair = mPairs[mLastPair];
+    const float previousWeight = weightOf(pair);
+    pair.failure += mSettings.failureRate * (static_cast<float>(!isSuccess) - pair.failure);
+    mBucketWeights[mLastBucket] += weightOf(pair) - previousWeight;
+}
+
+const PairScheduler::Settings &PairScheduler::getSettings() const
+{
+    return mSettings;
+}
+
+void PairScheduler::setSettings(const PairScheduler::Settings &settings)
+{
+    mSettings = settings;
+    
+    // The failure boost may have changed, which changes every weight.
+    std::fill(mBucketWeights.begin(), mBucketWeights.end(), 0.f);
+    for (size_t bucket = 0; bucket < mBucketWeights.size(); ++bucket)
+    {
+        for (size_t i = mBucketStarts[bucket]; i < mBucketStarts[bucket + 1]; ++i)
+            mBucketWeights[bucket] += weightOf(mPairs[i]);
+    }
+}
+
+bool PairScheduler::isActive() const
+{
+    return mSettings.isEnabled && !mPairs.empty();
+}
+
+size_t PairScheduler::getPairCount() const
+{
+    return mPairs.size();
+}
+
+int PairScheduler::getUnlockedDistance() const
+{
+    if (mPairs.empty())
+        return 0;
+    return mPairs[mBucketStarts[mUnlockedBucket + 1] - 1].distance;
+}
+
+float PairScheduler::weightOf(const PairScheduler::Pair &pair) const
+{
+    return 1.f + mSettings.failureBoost * pair.failure;
+}
+
+void PairScheduler::search(const Grid &grid, int start, std::vector<int> &distances, std::vector<int> &cells)
+{
+    distances.assign(grid.getCellCount(), -1);
+    cells.clear();
+    
+    distances[start] = 0;
+    cells.push_back(start);
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        const int cell = cells[i];
+        for (int move = 0; move < moveCount; ++move)
+        {
+            if (!grid.canMove(cell, move))
+                continue;
+            const int neighbour = grid.getNeighbour(cell, move);
+            if (distances[neighbour] >= 0)
+                continue;
+            distances[neighbour] = distances[cell] + 1;
+            cells.push_back(neighbour);
+        }
+    }
+}
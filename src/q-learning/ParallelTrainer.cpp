@@ -0,0 +1,283 @@
+/**
+ * @file ParallelTrainer.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "ParallelTrainer.h"
+
+#include "Grid.h"
+#include "ConvergenceTracker.h"
+#include "Random.h"
+
+#include <atomic>
+#include <thread>
+
+namespace
+{
+    constexpr int actionCount = static_cast<int>(action::Count);
+    
+    /**
+     * @brief The shared table for Hogwild training. Relaxed atomics keep it free of data races without locks.
+     */
+    struct AtomicTable
+    {
+        std::vector<std::atomic<float>> values;
+        
+        explicit AtomicTable(const QTable &qTable)
+            : values(static_cast<size_t>(stateCount) * actionCount)
+        {
+            for (State state = 0; state < stateCount; ++state)
+                for (int i = 0; i < actionCount; ++i)
+                    values[state * actionCount + i].store(qTable[state][i], std::memory_order_relaxed);
+        }
+        
+        [[nodiscard]] ActionValues load(State state) const
+        {
+            ActionValues out;
+            for (int i = 0; i < actionCount; ++i)
+                out[i] = values[state * actionCount + i].load(std::memory_order_relaxed);
+            return out;
+        }
+        
+        void store(State state, int index, float value)
+        {
+            values[state * actionCount + index].store(value, std::memory_order_relaxed);
+        }
+        
+        void copyTo(QTable &qTable) const
+        {
+            for (State state = 0; state < stateCount; ++state)
+                qTable[state] = load(state);
+        }
+    };
+    
+    /**
+     * @brief A worker's own table for Averaged training.
+     */
+    struct LocalTable
+    {
+        QTable                                  table;
+        std::array<uint32_t, stateCount>        updates {};
+        
+        [[nodiscard]] const ActionValues &load(State state) const { return table[state]; }
+        
+        void store(State state, int index, float value)
+        {
+            table[state][index] = value;
+            ++updates[state];
+        }
+    };
+    
+    /**
+     * @brief Picks a random empty cell.
+     */
+    glm::ivec2 randomFreeCell(const Grid &grid, RandomStream &rng)
+    {
+        return grid.indexToVector(grid.getFreeCells().sample(rng));
+    }
+    
+    /**
+     * @brief Runs one epsilon-greedy training episode with the same one step updates as QlPathFinder::updateTrain()
+     * when traces, replay and Dyna-Q are off.
+     * @returns The number of steps taken.
+     */
+    template<typename Table>
+    uint64_t runEpisode(Table &table, Environment &environment, const ParallelTrainer::Settings &settings,
+                        float explorationRate, RandomStream &rng)
+    {
+        const Grid &grid = *environment.grid;
+        const glm::ivec2 start = randomFreeCell(grid, rng);
+        environment.goal = randomFreeCell(grid, rng);
+        environment.resetDistance(start);
+        
+        glm::ivec2 position = start;
+        State state = environment.generateState(position);
+        const float intoWall = environment.getRewards().intoWall;
+        
+        // Bellman's Equation.
+        auto update = [&table, &settings](State currentState, int move, float points, State nextState) {
+            const ActionValues next = table.load(nextState);
+            const float maxOfQ = *std::max_element(next.begin(), next.end());
+            const float bucket = table.load(currentState)[move];
+            const float target = points + settings.gamma * maxOfQ;
+            table.store(currentState, move, (1 - settings.alpha) * bucket + settings.alpha * target);
+        };
+        
+        for (uint64_t iteration = 0; iteration <= settings.iterationMax; ++iteration)
+        {
+            const ActionValues values = table.load(state);
+            int move = static_cast<int>(std::max_element(values.begin(), values.end()) - values.begin());
+            if (rng.nextFloat() < explorationRate)
+                move = static_cast<int>(rng.nextBounded(actionCount));
+            
+            // Walking into a wall gives two rewards, like Environment::undoAgent() followed by
+            // Environment::reward(). The agent stays where it is, so the second is always awayFromGoal.
+            const bool isIntoWall = !grid.canMove(grid.vectorToIndex(position), move);
+            if (isIntoWall)
+                update(state, move, intoWall, state);
+            else
+                position += getActionOffset(static_cast<action>(move));
+            
+            bool isAtGoal = false;
+            const State nextState = isIntoWall ? state : environment.generateState(position);
+            update(state, move, environment.calculateReward(position, isAtGoal), nextState);
+            
+            state = nextState;
+            if (isAtGoal)
+                return iteration + 1;
+        }
+        return settings.iterationMax + 1;
+    }
+    
+    /**
+     * @brief The same exploration schedule as QlPathFinder::resetTraining().
+     */
+    float getExplorationRate(uint64_t episode, const ParallelTrainer::Settings &settings)
+    {
+        const float percentage = static_cast<float>(episode) / static_cast<float>(settings.episodes);
+        return glm::max(settings.minExplorationRate, glm::smoothstep(1.f, 0.f, percentage));
+    }
+}
+
+ParallelTrainer::ParallelTrainer(const Environment &environment, const ParallelTrainer::Settings &settings)
+    : mEnvironment(environment), mSettings(settings)
+{
+    if (mEnvironment.grid != nullptr)
+        mEnvironment.grid = std::make_shared<Grid>(*mEnvironment.grid);
+    if (mSettings.threadCount == 0)
+        mSettings.threadCount = std::max(1u, std::thread::hardware_concurrency());
+    mSettings.mergeInterval = std::max<uint64_t>(1, mSettings.mergeInterval);
+}
+
+ParallelTrainer::Stats ParallelTrainer::train(QTable &qTable)
+{
+    Stats stats;
+    stats.threadCount = mSettings.threadCount;
+    if (mEnvironment.grid == nullptr || mEnvironment.grid->getFreeCells().count() == 0)
+        return stats;
+    
+    const auto startTime = std::chrono::steady_clock::now();
+    if (mSettings.trainingMode == mode::Hogwild)
+        trainHogwild(qTable, stats);
+    else
+        trainAveraged(qTable, stats);
+    const auto endTime = std::chrono::steady_clock::now();
+    
+    stats.seconds = std::chrono::duration<double>(endTime - startTime).count();
+    stats.episodesPerSecond = stats.seconds > 0.0 ? static_cast<double>(stats.episodes) / stats.seconds : 0.0;
+    evaluate(qTable, stats);
+    return stats;
+}
+
+void ParallelTrainer::evaluate(const QTable &qTable, ParallelTrainer::Stats &stats) const
+{
+    evaluate(qTable, mEnvironment, mSettings.iterationMax, stats);
+}
+
+void ParallelTrainer::evaluate(const QTable &qTable, const Environment &environment, uint64_t iterationMax,
+                               ParallelTrainer::Stats &stats)
+{
+    constexpr int evaluationCount = 200;
+    const auto pairs = ConvergenceTracker::makeEvaluationPairs(
+            *environment.grid, evaluationCount, ConvergenceTracker::evaluationSeed);
+    Environment copy = environment;
+    const ConvergenceTracker::Evaluation evaluation = ConvergenceTracker::evaluate(
+            qTable, copy, pairs, iterationMax);
+    
+    stats.successRate = evaluation.successRate;
+    stats.meanSteps = evaluation.meanSteps;
+}
+
+void ParallelTrainer::trainHogwild(QTable &qTable, ParallelTrainer::Stats &stats)
+{
+    AtomicTable shared(qTable);
+    std::atomic<uint64_t> nextEpisode { 0 };
+    std::atomic<uint64_t> steps { 0 };
+    
+    // Each worker gets its own stream of one seed, so runs with the same master seed pick the same episodes.
+    const uint64_t seed = getRandomStream().nextSeed();
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < mSettings.threadCount; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            Environment environment = mEnvironment;
+            RandomStream rng(seed, i);
+            uint64_t localSteps = 0;
+            for (uint64_t episode = nextEpisode++; episode < mSettings.episodes; episode = nextEpisode++)
+                localSteps += runEpisode(shared, environment, mSettings, getExplorationRate(episode, mSettings), rng);
+            steps += localSteps;
+        });
+    }
+    
+    for (std::thread &thread : threads)
+        thread.join();
+    
+    shared.copyTo(qTable);
+    stats.episodes = mSettings.episodes;
+    stats.steps = steps;
+}
+
+void ParallelTrainer::trainAveraged(QTable &qTable, ParallelTrainer::Stats &stats)
+{
+    const unsigned int threadCount = mSettings.threadCount;
+    std::vector<std::unique_ptr<LocalTable>> locals;
+    std::vector<Environment> environments(threadCount, mEnvironment);
+    std::vector<RandomStream> rngs;
+    std::vector<uint64_t> steps(threadCount, 0);
+    const uint64_t seed = getRandomStream().nextSeed();
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        locals.emplace_back(std::make_unique<LocalTable>());
+        rngs.emplace_back(seed, i);
+    }
+    
+    uint64_t episode = 0;
+    while (episode < mSettings.episodes)
+    {
+        // Every worker starts the round from the merged table.
+        const uint64_t roundEpisodes = std::min(mSettings.mergeInterval * threadCount, mSettings.episodes - episode);
+        std::vector<std::thread> threads;
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                LocalTable &local = *locals[i];
+                local.table = qTable;
+                local.updates.fill(0);
+                for (uint64_t j = i; j < roundEpisodes; j += threadCount)
+                {
+                    const float explorationRate = getExplorationRate(episode + j, mSettings);
+                    steps[i] += runEpisode(local, environments[i], mSettings, explorationRate, rngs[i]);
+                }
+            });
+        }
+        
+        for (std::thread &thread : threads)
+            thread.join();
+        
+        // Weighted average. States that no one updated keep their value.
+        for (State state = 0; state < stateCount; ++state)
+        {
+            uint64_t totalUpdates = 0;
+            ActionValues sum {};
+            for (const auto &local : locals)
+            {
+                totalUpdates += local->updates[state];
+                for (int a = 0; a < actionCount; ++a)
+                    sum[a] += static_cast<float>(local->updates[state]) * local->table[state][a];
+            }
+            
+            if (totalUpdates == 0)
+                continue;
+            for (int a = 0; a < actionCount; ++a)
+                qTable[state][a] = sum[a] / static_cast<float>(totalUpdates);
+        }
+        
+        episode += roundEpisodes;
+    }
+    
+    stats.episodes = episode;
+    for (const uint64_t workerSteps : steps)
+        stats.steps += workerSteps;
+}
@@ -10,14 +10,21 @@
 #include "Grid.h"
 #include "FileIoCommon.h"
 #include "AiLoader.h"
+#include "Common.h"
+#include "Random.h"
 
 #include <imgui.h>
+#include <chrono>
 #include <fstream>
 
 void QlPathFinder::init(const std::shared_ptr<Grid>& grid)
 {
     mEnvironment.grid = grid;
     mEpisode = 0ull;
+    mAgent.clearReplay();
+    mAgent.clearModel();
+    mConvergence.reset(*grid, mConvergence.getSettings());
+    mScheduler.reset(*grid, mScheduler.getSettings());
 }
 
 void QlPathFinder::update()
@@ -33,12 +40,26 @@ void QlPathFinder::update()
 void QlPathFinder::updateTrain()
 {
     mAgent.performTrainingAction(mEnvironment.state);
-    if (!mEnvironment.verifyAgent(mAgent))
+    const bool isIntoWall = !mEnvironment.verifyAgent(mAgent);
+    if (isIntoWall)
         mEnvironment.undoAgent(mAgent);
     
-    State nextState    = mEnvironment.generateState(mAgent.getPosition());
-    mIsEpisodeFinished = mEnvironment.reward(mAgent, nextState) || mIteration++ >= mIterationMax;
+    State nextState = mEnvironment.generateState(mAgent.getPosition());
+    float points;
+    const bool isAtGoal = mEnvironment.reward(mAgent, nextState, points);
+    
+    // Walking into a wall gives two rewards. The model only learns the wall's, once.
+    mAgent.plan(isIntoWall ? mEnvironment.getRewards().intoWall : points, mEnvironment.state, nextState);
+    
+    mIsEpisodeFinished = isAtGoal || mIteration++ >= mIterationMax;
     mEnvironment.state = nextState;
+    
+    if (mIsEpisodeFinished)
+    {
+        mConvergence.endEpisode(isAtGoal, mAgent.getChanges(), mAgent.getQTable(), mEnvironment, mIterationMax);
+        if (mEpisode >= mEpisodeMax)
+            mConvergence.finish();
+    }
 }
 
 std::vector<int> QlPathFinder::calculatePath(const glm::ivec2 &start, const glm::ivec2 &end)
@@ -72,6 +93,96 @@ std::vector<int> QlPathFinder::trainPath(const glm::ivec2 &start, const glm::ive
     return path;
 }
 
+std::vector<int> QlPathFinder::trainScheduledPath()
+{
+    const PairScheduler::Pair &pair = mScheduler.next(getProgress());
+    const Grid &grid = *mEnvironment.grid;
+    
+    auto path = trainPath(grid.indexToVector(pair.start), grid.indexToVector(pair.goal));
+    mScheduler.report(mAgent.getPosition() == mEnvironment.goal);
+    return path;
+}
+
+ParallelTrainer::Stats QlPathFinder::trainParallel(ParallelTrainer::Settings settings)
+{
+    settings.episodes           = mEpisodeMax;
+    settings.iterationMax       = mIterationMax;
+    settings.alpha              = mAgent.getLearningRate();
+    settings.gamma              = mAgent.getDiscountFactor();
+    settings.minExplorationRate = mAgent.getMinExplorationRate();
+    
+    auto qTable = std::make_unique<QTable>(mAgent.getQTable());
+    ParallelTrainer trainer(mEnvironment, settings);
+    const ParallelTrainer::Stats stats = trainer.train(*qTable);
+    
+    mAgent.setQTable(*qTable);
+    mAgent.setExplorationRate(0.f);
+    mEpisode = mEpisodeMax;
+    mConvergence.finish();
+    return stats;
+}
+
+ParallelTrainer::Stats QlPathFinder::trainSerial()
+{
+    const Grid &grid = *mEnvironment.grid;
+    RandomStream &rng = getRandomStream();
+    
+    ParallelTrainer::Stats stats;
+    stats.threadCount = 1;
+    const auto startTime = std::chrono::steady_clock::now();
+    while (!isTrainingFinished())
+    {
+        const bool isScheduled = mScheduler.isActive();
+        if (isScheduled)
+        {
+            const PairScheduler::Pair &pair = mScheduler.next(getProgress());
+            resetTraining(grid.indexToVector(pair.start), grid.indexToVector(pair.goal));
+        }
+        else
+        {
+            const glm::ivec2 start = grid.indexToVector(grid.getFreeCells().sample(rng));
+            resetTraining(start, grid.indexToVector(grid.getFreeCells().sample(rng)));
+        }
+        
+        while (!mIsEpisodeFinished)
+        {
+            updateTrain();
+            ++stats.steps;
+        }
+        
+        if (isScheduled)
+            mScheduler.report(mAgent.getPosition() == mEnvironment.goal);
+        ++stats.episodes;
+    }
+    
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - startTime;
+    stats.seconds = seconds.count();
+    stats.episodesPerSecond = stats.seconds > 0.0 ? static_cast<double>(stats.episodes) / stats.seconds : 0.0;
+    ParallelTrainer::evaluate(mAgent.getQTable(), mEnvironment, mIterationMax, stats);
+    return stats;
+}
+
+BatchEnvironment::Stats QlPathFinder::trainBatched(int agentCount)
+{
+    BatchEnvironment::Settings settings;
+    settings.agentCount         = agentCount;
+    settings.episodes           = mEpisodeMax;
+    settings.iterationMax       = mIterationMax;
+    settings.alpha              = mAgent.getLearningRate();
+    settings.gamma              = mAgent.getDiscountFactor();
+    settings.minExplorationRate = mAgent.getMinExplorationRate();
+    
+    auto qTable = std::make_unique<QTable>(mAgent.getQTable());
+    BatchEnvironment batch(mEnvironment.grid, mEnvironment.getRewards(), agentCount, getRandomStream().nextSeed());
+    const BatchEnvironment::Stats stats = batch.train(*qTable, settings);
+    
+    mAgent.setQTable(*qTable);
+    mAgent.setExplorationRate(0.f);
+    mEpisode = mEpisodeMax;
+    mConvergence.finish();
+    return stats;
+}
+
 void QlPathFinder::reset(const glm::ivec2 &start, const glm::ivec2 &end)
 {
     mAgent.setPosition(start);
@@ -86,6 +197,8 @@ void QlPathFinder::resetTraining(const glm::ivec2 &start, const glm::ivec2 &end)
     mAgent.setPosition(start);
     mEnvironment.goal = end;
     mEnvironment.state = mEnvironment.generateState(mAgent.getPosition());
+    mAgent.clearTraces();
+    mAgent.resetChanges();
     mIsEpisodeFinished = false;
     mEpisode++;
     const float percentage = static_cast<float>(mEpisode) / static_cast<float>(mEpisodeMax);
@@ -101,6 +214,33 @@ void QlPathFinder::renderOptions()
     ImGui::DragScalar("Maximum Iterations", ImGuiDataType_U64, &mIterationMax, 100.f);
     mAgent.renderOptions();
     mEnvironment.renderOptions();
+    
+    ConvergenceTracker::Settings settings = mConvergence.getSettings();
+    ImGui::DragScalar("Episodes Between Evaluations", ImGuiDataType_U64, &settings.evaluationInterval, 10.f);
+    ImGui::Checkbox("Stop Early", &settings.isEnabled);
+    if (settings.isEnabled)
+    {
+        ImGui::DragScalar("Minimum Episodes", ImGuiDataType_U64, &settings.minEpisodes, 100.f);
+        ImGui::DragFloat("Max |dQ| Threshold", &settings.deltaThreshold, 0.0001f, 0.f, 1.f, "%.4f");
+        ImGui::DragScalar("Calm Episodes Needed", ImGuiDataType_U64, &settings.deltaPatience, 10.f);
+        ImGui::SliderFloat("Window Success Target", &settings.successThreshold, 0.f, 1.1f);
+        ImGui::SliderFloat("Evaluation Success Target", &settings.evaluationTarget, 0.f, 1.f);
+        ImGui::DragInt("Evaluations Without Improving", &settings.evaluationPatience, 1.f, 0, 100);
+    }
+    mConvergence.setSettings(settings);
+    
+    PairScheduler::Settings curriculum = mScheduler.getSettings();
+    if (ImGui::Checkbox("Curriculum", &curriculum.isEnabled))
+        setPairSchedulerSettings(curriculum);
+    if (curriculum.isEnabled)
+    {
+        bool hasChanged = ImGui::SliderFloat("Curriculum Ramp", &curriculum.rampFraction, 0.01f, 1.f);
+        hasChanged |= ImGui::DragFloat("Failure Boost", &curriculum.failureBoost, 0.1f, 0.f, 100.f);
+        if (hasChanged)
+            mScheduler.setSettings(curriculum);
+        ImGui::Text("Curriculum Pairs: %zu (up to %d steps)",
+                    mScheduler.getPairCount(), mScheduler.getUnlockedDistance());
+    }
 }
 
 void QlPathFinder::renderTrainingStats()
@@ -108,11 +248,92 @@ void QlPathFinder::renderTrainingStats()
     ImGui::Text("Episode: %llu", mEpisode);
     ImGui::Text("Iteration: %llu", mIteration);
     ImGui::Text("Exploration Rate: %f", mAgent.getExplorationRate());
+    
+    const ConvergenceTracker::Stats &stats = mConvergence.getStats();
+    ImGui::Text("Last Episode |dQ|: max %f, mean %f", stats.lastMaxDelta, stats.lastMeanDelta);
+    ImGui::Text("Recent Success Rate: %.1f%%", stats.windowSuccessRate * 100.f);
+    if (stats.evaluations > 0)
+        ImGui::Text("Greedy Success Rate: %.1f%% (best %.1f%%)",
+                    stats.lastEvaluation.successRate * 100.f, stats.bestEvaluation.successRate * 100.f);
+    ImGui::Text("Status: %s", ConvergenceTracker::toString(stats.reason).data());
 }
 
 bool QlPathFinder::isTrainingFinished() const
 {
-    return mEpisode >= mEpisodeMax;
+    return mEpisode >= mEpisodeMax || mConvergence.shouldStop();
+}
+
+bool QlPathFinder::isEpisodeFinished() const
+{
+    return mIsEpisodeFinished;
+}
+
+void QlPathFinder::setEpisodeMax(uint64_t episodeMax)
+{
+    mEpisodeMax = episodeMax;
+}
+
+void QlPathFinder::setIterationMax(uint64_t iterationMax)
+{
+    mIterationMax = iterationMax;
+}
+
+uint64_t QlPathFinder::getEpisodeMax() const
+{
+    return mEpisodeMax;
+}
+
+uint64_t QlPathFinder::getIterationMax() const
+{
+    return mIterationMax;
+}
+
+void QlPathFinder::setConvergenceSettings(const ConvergenceTracker::Settings &settings)
+{
+    mConvergence.setSettings(settings);
+}
+
+const ConvergenceTracker &QlPathFinder::getConvergence() const
+{
+    return mConvergence;
+}
+
+void QlPathFinder::setPairSchedulerSettings(const PairScheduler::Settings &settings)
+{
+    if (mEnvironment.grid)
+        mScheduler.reset(*mEnvironment.grid, settings);
+    else
+        mScheduler.setSettings(settings);
+}
+
+const PairScheduler &QlPathFinder::getPairScheduler() const
+{
+    return mScheduler;
+}
+
+void QlPathFinder::setTraceDecay(float lambda)
+{
+    mAgent.setTraceDecay(lambda);
+}
+
+void QlPathFinder::setReplaySettings(const ReplayBuffer::Settings &settings)
+{
+    mAgent.setReplaySettings(settings);
+}
+
+const ReplayBuffer &QlPathFinder::getReplayBuffer() const
+{
+    return mAgent.getReplayBuffer();
+}
+
+void QlPathFinder::setPlanningSteps(int steps)
+{
+    mAgent.setPlanningSteps(steps);
+}
+
+const DynaModel &QlPathFinder::getModel() const
+{
+    return mAgent.getModel();
 }
 
 void QlPathFinder::saveAi(std::string_view path, std::string_view name) const
@@ -149,3 +370,8 @@ void QlPathFinder::loadAi(std::string_view path)
     mEnvironment.load(data);
     mAgent.load(data);
 }
+
+float QlPathFinder::getProgress() const
+{
+    return mEpisodeMax > 0 ? static_cast<float>(mEpisode) / static_cast<float>(mEpisodeMax) : 1.f;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file ReplayBuffer.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "ReplayBuffer.h"
+
+#include "Random.h"
+
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr uint16_t stateMask        = (1u << ReplayBuffer::actionShift) - 1u;
+    constexpr float    priorityEpsilon  = 0.01f;  // Stops a transition with no error from never being replayed.
+    
+    static_assert(stateCount <= stateMask + 1, "States no longer fit below the action bits of a transition.");
+    static_assert(sizeof(ReplayBuffer::Transition) == 8, "Transitions should stay packed.");
+    
+    uint32_t nextPowerOfTwo(uint32_t value)
+    {
+        uint32_t power = 1;
+        while (power < value)
+            power <<= 1u;
+        return power;
+    }
+    
+    size_t memoryFor(uint32_t capacity, ReplayBuffer::sampling samplingMode)
+    {
+        size_t bytes = capacity * sizeof(ReplayBuffer::Transition);
+        if (samplingMode == ReplayBuffer::sampling::Prioritised)
+            bytes += 2 * nextPowerOfTwo(capacity) * sizeof(float);
+        return bytes;
+    }
+}
+
+ReplayBuffer::ReplayBuffer(const ReplayBuffer::Settings &settings)
+    : mSettings(settings)
+{
+    mSettings.batchSize      = glm::max(mSettings.batchSize, 1u);
+    mSettings.replayInterval = glm::max(mSettings.replayInterval, 1u);
+    
+    mTransitions.resize(mSettings.capacity);
+    mBatch.resize(mSettings.batchSize);
+    mBatchWeights.resize(mSettings.batchSize, 1.f);
+    
+    if (mSettings.samplingMode == sampling::Prioritised && mSettings.capacity > 0)
+    {
+        mLeafCount = nextPowerOfTwo(mSettings.capacity);
+        mPriorityTree.resize(2 * mLeafCount, 0.f);
+    }
+}
+
+void ReplayBuffer::add(State state, action agentAction, float reward, State nextState)
+{
+    if (!isEnabled())
+        return;
+    
+    const auto stateAction = static_cast<uint16_t>(state | (static_cast<uint16_t>(agentAction) << actionShift));
+    mTransitions[mNext] = { reward, stateAction, nextState };
+    if (mSettings.samplingMode == sampling::Prioritised)
+        setPriority(mNext, mMaxPriority);
+    
+    if (++mNext == mSettings.capacity)
+        mNext = 0;
+    mSize = glm::min(mSize + 1, mSettings.capacity);
+}
+
+QChanges ReplayBuffer::step(QTable &qTable, float alpha, float gamma)
+{
+    if (!isEnabled() || ++mStepsSinceReplay < mSettings.replayInterval || mSize < mSettings.batchSize)
+        return { };
+    
+    mStepsSinceReplay = 0;
+    return replay(qTable, alpha, gamma);
+}
+
+QChanges ReplayBuffer::replay(QTable &qTable, float alpha, float gamma)
+{
+    QChanges changes;
+    if (mSize == 0)
+        return changes;
+    
+    sampleBatch();
+    
+    const bool isPrioritised = mSettings.samplingMode == sampling::Prioritised;
+    for (uint32_t i = 0; i < mSettings.batchSize; ++i)
+    {
+        const Transition &transition = mTransitions[mBatch[i]];
+        const State state       = transition.stateAction & stateMask;
+        const int   actionIndex = transition.stateAction >> actionShift;
+        
+        const ActionValues &next = qTable[transition.nextState];
+        float maxOfQ = next[0];
+        for (size_t j = 1; j < next.size(); ++j)
+            maxOfQ = glm::max(maxOfQ, next[j]);
+        
+        // Bellman's Equation, written as a step towards the target so that it can be weighted.
+        float &bucket = qTable[state][actionIndex];
+        const float error = transition.reward + gamma * maxOfQ - bucket;
+        const float delta = alpha * mBatchWeights[i] * error;
+        bucket += delta;
+        changes.add(glm::abs(delta));
+        
+        if (isPrioritised)
+        {
+            const float priority = std::pow(std::abs(error) + priorityEpsilon, mSettings.priorityExponent);
+            mMaxPriority = glm::max(mMaxPriority, priority);
+            setPriority(mBatch[i], priority);
+        }
+    }
+    return changes;
+}
+
+void ReplayBuffer::clear()
+{
+    mNext = 0;
+    mSize = 0;
+    mStepsSinceReplay = 0;
+    mMaxPriority = 1.f;
+    std::fill(mPriorityTree.begin(), mPriorityTree.end(), 0.f);
+}
+
+bool ReplayBuffer::isEnabled() const
+{
+    return mSettings.capacity > 0;
+}
+
+uint32_t ReplayBuffer::getSize() const
+{
+    return mSize;
+}
+
+const ReplayBuffer::Settings &ReplayBuffer::getSettings() const
+{
+    return mSettings;
+}
+
+size_t ReplayBuffer::getMemoryUsage() const
+{
+    return mTransitions.size() * sizeof(Transition)
+           + mPriorityTree.size() * sizeof(float)
+           + mBatch.size() * sizeof(uint32_t)
+           + mBatchWeights.size() * sizeof(float);
+}
+
+uint32_t ReplayBuffer::capacityForBytes(size_t bytes, ReplayBuffer::sampling samplingMode)
+{
+    // Prioritised memory jumps at each power of two, so search for the largest capacity that fits.
+    uint64_t low  = 0;
+    uint64_t high = glm::min<uint64_t>(bytes / sizeof(Transition), std::numeric_limits<uint32_t>::max() / 2);
+    while (low < high)
+    {
+        const uint64_t middle = (low + high + 1) / 2;
+        if (memoryFor(static_cast<uint32_t>(middle), samplingMode) <= bytes)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+    return static_cast<uint32_t>(low);
+}
+
+void ReplayBuffer::sampleBatch()
+{
+    RandomStream &rng = getRandomStream();
+    if (mSettings.samplingMode == sampling::Uniform)
+    {
+        for (uint32_t i = 0; i < mSettings.batchSize; ++i)
+            mBatch[i] = rng.nextBounded(mSize);
+        return;
+    }
+    
+    // Stratified: one sample from each equal slice of the total priority so that a batch isn't all one transition.
+    const float total   = mPriorityTree[1];
+    const float segment = total / static_cast<float>(mSettings.batchSize);
+    float maxWeight = 0.f;
+    for (uint32_t i = 0; i < mSettings.batchSize; ++i)
+    {
+        const float value = glm::min((static_cast<float>(i) + rng.nextFloat()) * segment, std::nextafter(total, 0.f));
+        mBatch[i] = findPriority(value);
+        
+        const float probability = mPriorityTree[mLeafCount + mBatch[i]] / total;
+        mBatchWeights[i] = std::pow(static_cast<float>(mSize) * probability, -mSettings.importanceExponent);
+        maxWeight = glm::max(maxWeight, mBatchWeights[i]);
+    }
+    
+    for (uint32_t i = 0; i < mSettings.batchSize; ++i)
+        mBatchWeights[i] /= maxWeight;
+}
+
+void ReplayBuffer::setPriority(uint32_t index, float priority)
+{
+    // Sums are rebuilt from their children rather than adding a difference so that rounding errors don't build up.
+    uint32_t node = mLeafCount + index;
+    mPriorityTree[node] = priority;
+    for (node >>= 1u; node > 0; node >>= 1u)
+        mPriorityTree[node] = mPriorityTree[2 * node] + mPriorityTree[2 * node + 1];
+}
+
+uint32_t ReplayBuffer::findPriority(float value) const
+{
+    uint32_t node = 1;
+    while (node < mLeafCount)
+    {
+        const uint32_t left = 2 * node;
+        if (value < mPriorityTree[left])
+        {
+            node = left;
+        }
+        else
+        {
+            value -= mPriorityTree[left];
+            node = left + 1;
+        }
+    }
+    return glm::min(node - mLeafCount, mSize - 1);
+}
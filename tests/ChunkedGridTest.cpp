@@ -0,0 +1,86 @@
+/**
+ * @file ChunkedGridTest.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "TestMazes.h"
+#include "ChunkedGrid.h"
+#include "SnapshotStore.h"
+
+// Checks that a ChunkedGrid gives the same cells and move masks as the dense Grid, both when it's copied from one
+// and after the same edits are made to both. Snapshots published through a SnapshotStore must keep the cells they
+// were published with while the working copy is edited.
+
+namespace
+{
+    constexpr int editRounds = 20;
+    constexpr int roundEdits = 10;
+    
+    /**
+     * @returns The number of cells where the chunked grid disagrees with the dense grid.
+     */
+    int compare(const Grid &grid, const ChunkedGrid &chunked)
+    {
+        int failures = 0;
+        for (int cell = 0; cell < grid.getCellCount(); ++cell)
+        {
+            const glm::ivec2 pos = grid.indexToVector(cell);
+            failures += chunked.getCellType(pos) != grid.getCellType(cell);
+            failures += chunked.getMoveMask(pos) != grid.getMoveMask(cell);
+        }
+        return failures;
+    }
+    
+    int checkMaze(const test::Maze &maze)
+    {
+        Grid grid(maze.cells, maze.width);
+        RandomStream rng(1ull);
+        
+        SnapshotStore<ChunkedGrid> store { ChunkedGrid(grid) };
+        int failures = compare(grid, store.edit());
+        
+        for (int round = 0; round < editRounds; ++round)
+        {
+            const Grid before = grid;
+            const auto pinned = store.acquire();
+            
+            for (int i = 0; i < roundEdits; ++i)
+            {
+                const auto [min, max] = test::randomEdit(grid, rng);
+                const Grid::cellType type = grid.getCellType(grid.vectorToIndex(min));
+                if (min == max)
+                    store.edit().setCell(min, type);
+                else
+                    store.edit().fillRect(min, max, type);
+            }
+            
+            failures += compare(grid, store.edit());
+            store.publish();
+            failures += compare(before, *pinned);  // Edits to the working copy must not leak into the snapshot.
+            failures += compare(grid, *store.acquire());
+        }
+        
+        std::cout << maze.name << ": " << failures << " mismatches. " << grid.getMemoryUsage() << " bytes dense, "
+                  << store.edit().getMemoryUsage() << " bytes chunked.\n";
+        return failures;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<test::Maze> mazes;
+    if (!test::loadMazes(argc, argv, 150, mazes))
+    {
+        std::cout << "Usage: ChunkedGridTest <maze paths...>\n";
+        return 1;
+    }
+    
+    int failures = 0;
+    for (const test::Maze &maze : mazes)
+        failures += checkMaze(maze);
+    
+    std::cout << (failures == 0 ? "Passed.\n" : "Failed: the chunked grid disagreed with the dense grid.\n");
+    return failures == 0 ? 0 : 1;
+}
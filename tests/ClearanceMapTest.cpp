@@ -0,0 +1,70 @@
+/**
+ * @file ClearanceMapTest.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "TestMazes.h"
+#include "ClearanceMap.h"
+
+// Checks that a ClearanceMap kept up to date with sync() or onCellsChanged() holds exactly the same clearances as
+// one rebuilt from scratch, for both metrics and for a cap that edits often reach.
+
+namespace
+{
+    constexpr int editRounds = 20;
+    constexpr int roundEdits = 10;
+    constexpr std::array<int, 2> maxClearances { 3, 16 };
+    
+    int checkMaze(const test::Maze &maze, ClearanceMap::metric distanceMetric, int maxClearance)
+    {
+        Grid grid(maze.cells, maze.width);
+        RandomStream rng(1ull);
+        
+        ClearanceMap synced(grid, distanceMetric, maxClearance);
+        ClearanceMap patched(grid, distanceMetric, maxClearance);
+        int failures = 0;
+        for (int round = 0; round < editRounds; ++round)
+        {
+            for (int i = 0; i < roundEdits; ++i)
+            {
+                const auto [min, max] = test::randomEdit(grid, rng);
+                patched.onCellsChanged(grid, min, max);
+            }
+            synced.sync(grid);
+            const ClearanceMap rebuilt(grid, distanceMetric, maxClearance);
+            
+            failures += synced.getClearances() != rebuilt.getClearances();
+            failures += patched.getClearances() != rebuilt.getClearances();
+        }
+        
+        std::cout << maze.name << (distanceMetric == ClearanceMap::metric::Chessboard ? " chessboard" : " euclidean")
+                  << " capped at " << maxClearance << ": " << failures << " of " << editRounds * 2
+                  << " checks differed from a rebuild.\n";
+        return failures;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<test::Maze> mazes;
+    if (!test::loadMazes(argc, argv, 100, mazes))
+    {
+        std::cout << "Usage: ClearanceMapTest <maze paths...>\n";
+        return 1;
+    }
+    
+    int failures = 0;
+    for (const test::Maze &maze : mazes)
+    {
+        for (const int maxClearance : maxClearances)
+        {
+            failures += checkMaze(maze, ClearanceMap::metric::Chessboard, maxClearance);
+            failures += checkMaze(maze, ClearanceMap::metric::Euclidean, maxClearance);
+        }
+    }
+    
+    std::cout << (failures == 0 ? "Passed.\n" : "Failed: incremental updates differed from a rebuild.\n");
+    return failures == 0 ? 0 : 1;
+}
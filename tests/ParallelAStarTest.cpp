@@ -0,0 +1,72 @@
+/**
+ * @file ParallelAStarTest.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "TestMazes.h"
+#include "ParallelPathfinding.h"
+#include "SearchContext.h"
+#include "Random.h"
+
+// Checks that hash distributed A* (ParallelAStarGrid()) finds paths that are as short as the single threaded A* in
+// SearchContext, whatever the number of workers.
+
+namespace
+{
+    constexpr int pairCount = 30;  // Per maze. Each search starts its own threads.
+    constexpr std::array<unsigned int, 3> threadCounts { 1u, 2u, 4u };
+    
+    /**
+     * @returns The number of pairs where a path was the wrong length or not a legal path.
+     */
+    int checkMaze(const test::Maze &maze)
+    {
+        const Grid grid(maze.cells, maze.width);
+        const FreeCellIndex &freeCells = grid.getFreeCells();
+        SearchContext context;
+        RandomStream rng(1ull);
+        
+        int failures = 0;
+        for (int i = 0; i < pairCount; ++i)
+        {
+            const int start = freeCells.sample(rng);
+            const int end   = freeCells.sample(rng);
+            const std::vector<int> expected = context.findPath(grid, start, end);
+            for (const unsigned int threadCount : threadCounts)
+            {
+                const std::vector<int> path = ParallelAStarGrid(grid, start, end, threadCount);
+                const bool isCorrect = expected.empty() ? path.empty()
+                                                        : path.size() == expected.size()
+                                                          && test::isValidPath(grid, path, start, end);
+                if (isCorrect)
+                    continue;
+                
+                ++failures;
+                std::cout << maze.name << ": " << start << " -> " << end << " with " << threadCount << " thread(s) was "
+                          << path.size() << " cells long, A* was " << expected.size() << ".\n";
+            }
+        }
+        
+        std::cout << maze.name << ": " << failures << " of " << pairCount * threadCounts.size() << " searches failed.\n";
+        return failures;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<test::Maze> mazes;
+    if (!test::loadMazes(argc, argv, 100, mazes))
+    {
+        std::cout << "Usage: ParallelAStarTest <maze paths...>\n";
+        return 1;
+    }
+    
+    int failures = 0;
+    for (const test::Maze &maze : mazes)
+        failures += checkMaze(maze);
+    
+    std::cout << (failures == 0 ? "Passed.\n" : "Failed: some paths did not match A*.\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file RectangleGraphTest.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "TestMazes.h"
+#include "RectangleGraph.h"
+#include "SearchContext.h"
+
+// Checks that RectangleGraph covers every empty cell and finds a legal path whenever A* does, both when it is built
+// from scratch and after edits are patched in with sync() or onCellsChanged(). The rectangle search isn't optimal,
+// so its paths only have to be at least as long as A*'s.
+
+namespace
+{
+    constexpr int pairCount   = 20;
+    constexpr int editRounds  = 10;
+    constexpr int roundEdits  = 10;
+    
+    /**
+     * @returns The number of cells that are in the wrong rectangle (or in one when they are a wall).
+     */
+    int checkOwners(const Grid &grid, const RectangleGraph &graph)
+    {
+        int failures = 0;
+        for (int cell = 0; cell < grid.getCellCount(); ++cell)
+        {
+            const int id = graph.getRectangle(cell);
+            if (!grid.verifyCell(cell))
+            {
+                failures += id != -1;
+                continue;
+            }
+            
+            const glm::ivec2 pos = grid.indexToVector(cell);
+            const bool isInside = id >= 0 && graph.getRectangles()[id].isAlive
+                                  && glm::all(glm::greaterThanEqual(pos, graph.getRectangles()[id].min))
+                                  && glm::all(glm::lessThanEqual(pos, graph.getRectangles()[id].max));
+            failures += !isInside;
+        }
+        return failures;
+    }
+    
+    /**
+     * @returns The number of pairs where the graph's path was illegal, shorter than A* or reached a different answer.
+     */
+    int checkPaths(const Grid &grid, const RectangleGraph &graph, SearchContext &context, RandomStream &rng)
+    {
+        const FreeCellIndex &freeCells = grid.getFreeCells();
+        if (freeCells.count() == 0)
+            return 0;
+        
+        int failures = 0;
+        for (int i = 0; i < pairCount; ++i)
+        {
+            const int start = freeCells.sample(rng);
+            const int end   = freeCells.sample(rng);
+            const std::vector<int> &expected = context.findPath(grid, start, end);
+            const std::vector<int> path = graph.findPath(start, end);
+            const bool isCorrect = expected.empty() ? path.empty()
+                                                    : path.size() >= expected.size()
+                                                      && test::isValidPath(grid, path, start, end);
+            failures += !isCorrect;
+        }
+        return failures;
+    }
+    
+    int checkMaze(const test::Maze &maze)
+    {
+        Grid grid(maze.cells, maze.width);
+        SearchContext context;
+        RandomStream rng(1ull);
+        
+        RectangleGraph synced(grid);
+        RectangleGraph patched(grid);
+        int failures = checkOwners(grid, synced) + checkPaths(grid, synced, context, rng);
+        
+        for (int round = 0; round < editRounds; ++round)
+        {
+            for (int i = 0; i < roundEdits; ++i)
+            {
+                const auto [min, max] = test::randomEdit(grid, rng);
+                patched.onCellsChanged(grid, min, max);
+            }
+            synced.sync(grid);
+            const RectangleGraph rebuilt(grid);
+            
+            for (const RectangleGraph *graph : std::array<const RectangleGraph*, 3> { &synced, &patched, &rebuilt })
+                failures += checkOwners(grid, *graph) + checkPaths(grid, *graph, context, rng);
+        }
+        
+        std::cout << maze.name << ": " << failures << " failures.\n";
+        return failures;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<test::Maze> mazes;
+    if (!test::loadMazes(argc, argv, 100, mazes))
+    {
+        std::cout << "Usage: RectangleGraphTest <maze paths...>\n";
+        return 1;
+    }
+    
+    int failures = 0;
+    for (const test::Maze &maze : mazes)
+        failures += checkMaze(maze);
+    
+    std::cout << (failures == 0 ? "Passed.\n" : "Failed: the graph disagreed with the grid.\n");
+    return failures == 0 ? 0 : 1;
+}
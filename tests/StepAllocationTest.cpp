@@ -0,0 +1,135 @@
+/**
+ * @file StepAllocationTest.cpp
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#include "QlPathFinder.h"
+#include "Grid.h"
+#include "MazeLoader.h"
+#include "Random.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Checks that a single threaded training step (QlPathFinder::updateTrain()) never allocates once it's warmed up.
+// Global operator new is replaced with one that counts, so anything in the step that reaches the heap is caught.
+
+namespace
+{
+    std::atomic<uint64_t> allocationCount { 0 };
+    
+    constexpr uint64_t warmUpEpisodes   = 200;
+    constexpr uint64_t checkedEpisodes  = 2000;
+    constexpr uint64_t iterationMax     = 500;
+    
+    /**
+     * @brief Trains for warmUpEpisodes and then counts the allocations made over the next checkedEpisodes.
+     * @param steps - Set to the number of steps that were checked.
+     * @returns The number of allocations made by the checked steps.
+     */
+    uint64_t countStepAllocations(QlPathFinder &pathFinder, const Grid &grid, uint64_t &steps)
+    {
+        RandomStream &rng = getRandomStream();
+        const FreeCellIndex &freeCells = grid.getFreeCells();
+        
+        uint64_t allocations = 0;
+        steps = 0;
+        for (uint64_t episode = 0; episode < warmUpEpisodes + checkedEpisodes; ++episode)
+        {
+            const glm::ivec2 start = grid.indexToVector(freeCells.sample(rng));
+            const glm::ivec2 goal  = grid.indexToVector(freeCells.sample(rng));
+            pathFinder.resetTraining(start, goal);
+            
+            const bool isChecked = episode >= warmUpEpisodes;
+            const uint64_t before = allocationCount;
+            while (!pathFinder.isEpisodeFinished())
+            {
+                pathFinder.updateTrain();
+                steps += isChecked;
+            }
+            if (isChecked)
+                allocations += allocationCount - before;
+        }
+        return allocations;
+    }
+    
+    bool check(std::string_view name, QlPathFinder &pathFinder, const Grid &grid)
+    {
+        uint64_t steps;
+        const uint64_t allocations = countStepAllocations(pathFinder, grid, steps);
+        std::cout << name << ": " << allocations << " allocations over " << steps << " steps.\n";
+        return allocations == 0 && steps > 0;
+    }
+}
+
+void *operator new(std::size_t size)
+{
+    ++allocationCount;
+    if (void *memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: StepAllocationTest <maze path>\n";
+        return 1;
+    }
+    
+    const fileSystem::MazeData data = fileSystem::loadMaze(argv[1]);
+    if (data.grid.empty())
+    {
+        std::cout << "Could not load the maze: " << argv[1] << "\n";
+        return 1;
+    }
+    
+    auto grid = std::make_shared<Grid>(data.grid, data.gridSize.x);
+    setRandomSeed(1ull);
+    
+    // Evaluations run inside updateTrain() at the end of an episode, so make sure some land in the checked episodes.
+    ConvergenceTracker::Settings convergence;
+    convergence.evaluationInterval = 100;
+    
+    bool isPassing = true;
+    {
+        auto pathFinder = std::make_unique<QlPathFinder>();
+        pathFinder->setConvergenceSettings(convergence);
+        pathFinder->init(grid);
+        pathFinder->setEpisodeMax(warmUpEpisodes + checkedEpisodes);
+        pathFinder->setIterationMax(iterationMax);
+        isPassing &= check("One step Q-learning", *pathFinder, *grid);
+    }
+    {
+        ReplayBuffer::Settings replay;
+        replay.capacity = 4096;
+        replay.samplingMode = ReplayBuffer::sampling::Prioritised;
+        
+        auto pathFinder = std::make_unique<QlPathFinder>();
+        pathFinder->setConvergenceSettings(convergence);
+        pathFinder->init(grid);
+        pathFinder->setEpisodeMax(warmUpEpisodes + checkedEpisodes);
+        pathFinder->setIterationMax(iterationMax);
+        pathFinder->setTraceDecay(0.8f);
+        pathFinder->setReplaySettings(replay);
+        pathFinder->setPlanningSteps(10);
+        isPassing &= check("Q(lambda), prioritised replay and Dyna-Q", *pathFinder, *grid);
+    }
+    
+    std::cout << (isPassing ? "Passed.\n" : "Failed: the training step allocated.\n");
+    return isPassing ? 0 : 1;
+}
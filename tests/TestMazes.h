@@ -0,0 +1,111 @@
+/**
+ * @file TestMazes.h
+ * @author Ryan Purse
+ * @date 18/10/2026
+ */
+
+
+#pragma once
+
+#ifdef NO_PCH
+#include "Pch.h"
+#endif  // NO_PCH
+
+#include "Grid.h"
+#include "MazeLoader.h"
+#include "Random.h"
+
+// Helpers shared by the tests. Every test is given the bundled mazes on the command line.
+
+namespace test
+{
+    /**
+     * @brief The cells of a maze and its width, ready to build a Grid or anything else from.
+     */
+    struct Maze
+    {
+        std::string name;
+        Grid::Cells cells;
+        int         width { 0 };
+    };
+    
+    /**
+     * @brief Repeats a maze side by side until it is at least minSize in both directions, so that the bundled mazes
+     * (which are tiny) can cover code that only runs on big grids, e.g. the edges of a ChunkedGrid chunk.
+     */
+    inline Maze tile(const Maze &maze, int minSize)
+    {
+        const int height = static_cast<int>(maze.cells.size()) / maze.width;
+        const int across = (minSize + maze.width - 1) / maze.width;
+        const int down   = (minSize + height - 1) / height;
+        
+        Maze tiled { maze.name + " (tiled)", { }, maze.width * across };
+        tiled.cells.reserve(static_cast<size_t>(tiled.width) * height * down);
+        for (int y = 0; y < height * down; ++y)
+        {
+            for (int x = 0; x < tiled.width; ++x)
+                tiled.cells.push_back(maze.cells[(x % maze.width) + (y % height) * maze.width]);
+        }
+        return tiled;
+    }
+    
+    /**
+     * @brief Loads every maze path given to the test, plus a copy of each one tiled to at least tiledSize.
+     * @returns False if any of them could not be loaded.
+     */
+    inline bool loadMazes(int argc, char *argv[], int tiledSize, std::vector<Maze> &out)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const fileSystem::MazeData data = fileSystem::loadMaze(argv[i]);
+            if (data.grid.empty())
+            {
+                std::cout << "Could not load the maze: " << argv[i] << "\n";
+                return false;
+            }
+            
+            out.push_back({ argv[i], data.grid, data.gridSize.x });
+            out.push_back(tile(out.back(), tiledSize));
+        }
+        return !out.empty();
+    }
+    
+    /**
+     * @brief Makes a random edit to the grid. Usually a single cell, sometimes a small rectangle.
+     * @returns The cells that were changed (inclusive), clamped to the grid.
+     */
+    inline std::pair<glm::ivec2, glm::ivec2> randomEdit(Grid &grid, RandomStream &rng)
+    {
+        const glm::ivec2 size = grid.getSize();
+        const glm::ivec2 pos(rng.nextBounded(size.x), rng.nextBounded(size.y));
+        const Grid::cellType type = rng.nextBounded(2) == 0 ? Grid::cellType::Empty : Grid::cellType::Wall;
+        if (rng.nextBounded(4) != 0)
+        {
+            grid.setCell(grid.vectorToIndex(pos), type);
+            return { pos, pos };
+        }
+        
+        const glm::ivec2 max = glm::min(pos + glm::ivec2(rng.nextBounded(6), rng.nextBounded(6)), size - 1);
+        grid.fillRect(pos, max, type);
+        return { pos, max };
+    }
+    
+    /**
+     * @returns True if the path goes from start to end and every step is a legal move on the grid.
+     */
+    inline bool isValidPath(const Grid &grid, const std::vector<int> &path, int start, int end)
+    {
+        if (path.empty() || path.front() != start || path.back() != end)
+            return false;
+        
+        for (size_t i = 1; i < path.size(); ++i)
+        {
+            bool isLegal = false;
+            for (int move = 0; move < 8; ++move)
+                isLegal |= grid.canMove(path[i - 1], move) && grid.getNeighbour(path[i - 1], move) == path[i];
+            if (!isLegal)
+                return false;
+        }
+        return true;
+    }
+}